@@ -87,6 +87,8 @@ int main() {
   world.MakeSteps(100);
 
   auto std_out = world.GetStdout(kHostName);
+  auto cache_stats = world.GetDbCacheStats(kHostName);
+  auto replay_stats = world.GetDbReplayStats(kHostName);
 
   size_t digest = world.Stop();
 
@@ -94,6 +96,14 @@ int main() {
             << ", time: " << world.TimeElapsed()
             << ", steps: " << world.StepCount() << std::endl;
 
+  std::cout << "Block cache: hits = " << cache_stats.hits
+            << ", misses = " << cache_stats.misses
+            << ", evictions = " << cache_stats.evictions
+            << ", hit ratio = " << cache_stats.HitRatio() << std::endl;
+  std::cout << "Replay: time = " << replay_stats.last_time.Count()
+            << ", checkpoint entries = " << replay_stats.last_checkpoint_entries
+            << ", wal records = " << replay_stats.last_wal_records << std::endl;
+
   std::cout << "Simulation log:" << std::endl;
   matrix::WriteTextLog(world.EventLog(), std::cout);
 
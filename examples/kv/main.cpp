@@ -28,6 +28,7 @@
 #include <matrix/test/runner.hpp>
 
 #include <matrix/time_model/catalog/crazy.hpp>
+#include <matrix/time_model/catalog/pct.hpp>
 
 #include <matrix/fault/access.hpp>
 #include <matrix/fault/net/star.hpp>
@@ -193,14 +194,17 @@ size_t RunSimulation(size_t seed) {
   static const Jiffies kTimeLimit = 20000_jfs;
   static const size_t kRequestsThreshold = 7;
 
+  // Shrinkable (see --shrink)
+  const size_t requests = runner.Param("requests", kRequestsThreshold);
+
   runner.Verbose() << "Simulation seed: " << seed << std::endl;
 
   matrix::Random random{seed};
 
   // Randomize simulation parameters
-  const size_t replicas = random.Get(3, 5);
-  const size_t clients = random.Get(2, 3);
-  const size_t keys = random.Get(1, 2);
+  const size_t replicas = runner.Param("replicas", random.Get(3, 5), 1);
+  const size_t clients = runner.Param("clients", random.Get(2, 3), 1);
+  const size_t keys = runner.Param("keys", random.Get(1, 2), 1);
 
   runner.Verbose() << "Parameters: "
                    << "replicas = " << replicas << ", "
@@ -215,7 +219,11 @@ size_t RunSimulation(size_t seed) {
   runner.Configure(world);
 
   // Time model
-  world.SetTimeModel(matrix::MakeCrazyTimeModel());
+  if (runner.Feature("pct", false)) {
+    world.SetTimeModel(matrix::MakePctTimeModel());
+  } else {
+    world.SetTimeModel(matrix::MakeCrazyTimeModel());
+  }
 
   // Cluster
   world.MakePool("kv", KVNodeMain).Size(replicas);
@@ -225,21 +233,26 @@ size_t RunSimulation(size_t seed) {
 
   // Adversaries
 
-  if (random.Maybe(3)) {
-    if (random.Maybe(3)) {
-      // Network partitions
-      world.AddAdversary(NetAdversary);
-    }
+  // Swarm mode: features are chosen by runner (see --swarm)
 
-    if (random.Maybe(7)) {
-      // Reboots, pauses
-      world.AddAdversary(NodeAdversary);
-    }
+  const bool faults = random.Maybe(3);
+  const bool partitions = faults && random.Maybe(3);
+  const bool reboots = faults && random.Maybe(7);
+  const bool crashes = faults && random.Maybe(11);
 
-    if (random.Maybe(11)) {
-      // Crashes
-      world.AddAdversary(NodeReaper);
-    }
+  if (runner.Param("net_adversary", runner.Feature("partitions", partitions))) {
+    // Network partitions
+    world.AddAdversary(NetAdversary);
+  }
+
+  if (runner.Param("node_adversary", runner.Feature("reboots", reboots))) {
+    // Reboots, pauses
+    world.AddAdversary(NodeAdversary);
+  }
+
+  if (runner.Param("node_reaper", runner.Feature("crashes", crashes))) {
+    // Crashes
+    world.AddAdversary(NodeReaper);
   }
 
   // Globals
@@ -249,12 +262,11 @@ size_t RunSimulation(size_t seed) {
   // Run simulation
 
   world.Start();
-  while (world.GetCounter("requests") < kRequestsThreshold &&
-         world.TimeElapsed() < kTimeLimit) {
-    if (!world.Step()) {
-      break;  // Deadlock
-    }
-  }
+  // Stops on deadlock as well
+  world.RunUntil([&world, requests]() {
+    return world.GetCounter("requests") >= requests ||
+           !(world.TimeElapsed() < kTimeLimit);
+  });
 
   // Stop and compute simulation digest
   size_t digest = world.Stop();
@@ -262,7 +274,9 @@ size_t RunSimulation(size_t seed) {
   // Print report
   runner.Verbose() << "Seed " << seed << " -> "
                    << "digest: " << digest << ", time: " << world.TimeElapsed()
-                   << ", steps: " << world.StepCount() << std::endl;
+                   << ", steps: " << world.StepCount()
+                   << " (skipped: " << world.SkippedSteps() << ")"
+                   << std::endl;
 
   const auto event_log = world.EventLog();
 
@@ -270,18 +284,17 @@ size_t RunSimulation(size_t seed) {
                    << std::endl;
 
   // Time limit exceeded
-  if (world.GetCounter("requests") < kRequestsThreshold) {
+  if (world.GetCounter("requests") < requests) {
     // Log
     runner.Report() << "Log:" << std::endl;
     matrix::WriteTextLog(event_log, runner.Report());
     runner.Report() << std::endl;
 
     if (world.TimeElapsed() < kTimeLimit) {
-      runner.Report() << "Deadlock in simulation" << std::endl;
+      runner.Fail("Deadlock in simulation");
     } else {
-      runner.Report() << "Simulation time limit exceeded" << std::endl;
+      runner.Fail("Simulation time limit exceeded");
     }
-    runner.Fail();
   }
 
   // Check linearizability
@@ -299,7 +312,7 @@ size_t RunSimulation(size_t seed) {
                     << std::endl;
     semantics::PrintKVHistory<kv::Key, kv::Value>(history, runner.Report());
 
-    runner.Fail();
+    runner.Fail("History is not linearizable");
   }
 
   return digest;
@@ -0,0 +1,109 @@
+// MemTable implementations
+#include <matrix/db/mem_table.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace whirl;
+using matrix::db::MemTableKind;
+
+//////////////////////////////////////////////////////////////////////
+
+// Real (not simulated) time
+
+class StopWatch {
+  using Clock = std::chrono::steady_clock;
+
+ public:
+  double ElapsedMillis() const {
+    auto elapsed = Clock::now() - start_;
+    return std::chrono::duration<double, std::milli>(elapsed).count();
+  }
+
+ private:
+  Clock::time_point start_ = Clock::now();
+};
+
+//////////////////////////////////////////////////////////////////////
+
+static std::vector<std::string> MakeKeys(size_t count, size_t seed) {
+  std::mt19937_64 twister{seed};
+
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    keys.push_back("key-" + std::to_string(twister()));
+  }
+  return keys;
+}
+
+void Benchmark(const std::string& name, MemTableKind kind,
+               const std::vector<std::string>& keys,
+               const std::vector<std::string>& misses) {
+  auto mem_table = matrix::db::MakeMemTable(kind);
+
+  double put_millis;
+  {
+    StopWatch stop_watch;
+    for (const auto& key : keys) {
+      mem_table->Put(key, "value");
+    }
+    put_millis = stop_watch.ElapsedMillis();
+  }
+
+  size_t found = 0;
+  matrix::db::MaybeValue value;
+
+  double get_millis;
+  {
+    StopWatch stop_watch;
+    for (const auto& key : keys) {
+      found += mem_table->TryGet(key, value) ? 1 : 0;
+    }
+    for (const auto& key : misses) {
+      found += mem_table->TryGet(key, value) ? 1 : 0;
+    }
+    get_millis = stop_watch.ElapsedMillis();
+  }
+
+  size_t scanned = 0;
+
+  double scan_millis;
+  {
+    StopWatch stop_watch;
+    mem_table->ForEach([&scanned](const node::db::Key&,
+                                  const matrix::db::MaybeValue&) {
+      ++scanned;
+    });
+    scan_millis = stop_watch.ElapsedMillis();
+  }
+
+  if (found != keys.size() || scanned != keys.size()) {
+    std::cout << name << ": invalid results" << std::endl;
+    std::abort();
+  }
+
+  std::cout << name << ": put = " << put_millis << "ms, get = " << get_millis
+            << "ms, scan = " << scan_millis << "ms" << std::endl;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  static const size_t kKeys = 200'000;
+
+  auto keys = MakeKeys(kKeys, /*seed=*/17);
+  auto misses = MakeKeys(kKeys, /*seed=*/42);
+
+  std::cout << "Keys: " << kKeys << std::endl;
+
+  Benchmark("Map", MemTableKind::Map, keys, misses);
+  Benchmark("Hash", MemTableKind::Hash, keys, misses);
+  Benchmark("SkipList", MemTableKind::SkipList, keys, misses);
+
+  return 0;
+}
@@ -11,6 +11,10 @@ std::string NodeConfig::GetString(std::string_view key) const {
     return server_.pool;
   }
 
+  if (key == "zone") {
+    return server_.options.zone;
+  }
+
   // Global constant
 
   if (key == "db.path") {
@@ -36,6 +40,10 @@ int64_t NodeConfig::GetInt64(std::string_view key) const {
     return server_.id;
   }
 
+  if (key == "rack") {
+    return server_.rack;
+  }
+
   // Global constant
 
   if (key == "rpc.port") {
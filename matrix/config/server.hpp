@@ -1,14 +1,42 @@
 #pragma once
 
+#include <matrix/db/options.hpp>
+#include <matrix/network/zone.hpp>
+
 #include <string>
 #include <cstdlib>
 
 namespace whirl::matrix {
 
+// Hardware / OS knobs, set per pool
+
+struct ServerOptions {
+  // Simulated CPU cores, 0 - unlimited (tasks take zero time)
+  size_t cpu_cores = 0;
+
+  // Topology
+  std::string zone = "default";
+  // Servers of pool are placed to racks round-robin
+  size_t racks = 1;
+
+  // Capacity of database block cache (bytes)
+  size_t db_block_cache = 16 * 1024;
+  db::MemTableKind db_mem_table = db::MemTableKind::Map;
+
+  // Transport flow control (bytes), 0 - unlimited
+  size_t net_send_window = 0;
+  size_t net_recv_buffer = 0;
+};
+
 struct ServerConfig {
   size_t id;
   std::string hostname;
   std::string pool;
+  ServerOptions options{};
+
+  // Resolved by world
+  net::ZoneId zone = 0;
+  size_t rack = 0;
 };
 
 }  // namespace whirl::matrix
@@ -0,0 +1,68 @@
+#include <matrix/db/bloom.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace whirl::matrix::db {
+
+// Portable hash, do not use std::hash here:
+// filters are persisted on (simulated) disk
+
+static uint32_t BloomHash(std::string_view key) {
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (char c : key) {
+    hash ^= (uint8_t)c;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+std::string BloomFilter::Build(const std::vector<node::db::Key>& keys,
+                               size_t bits_per_key) {
+  // k = bits_per_key * ln(2)
+  size_t probes = std::clamp<size_t>(bits_per_key * 69 / 100, 1, 30);
+
+  // Small filters have high false positive rate
+  size_t bits = std::max<size_t>(keys.size() * bits_per_key, 64);
+  size_t bytes = (bits + 7) / 8;
+  bits = bytes * 8;
+
+  std::string filter(bytes, '\0');
+  filter.push_back((char)probes);
+
+  for (const auto& key : keys) {
+    // Double hashing
+    uint32_t h = BloomHash(key);
+    const uint32_t delta = (h >> 17) | (h << 15);
+    for (size_t j = 0; j < probes; ++j) {
+      const uint32_t bit = h % bits;
+      filter[bit / 8] |= (char)(1 << (bit % 8));
+      h += delta;
+    }
+  }
+
+  return filter;
+}
+
+bool BloomFilter::MayContain(std::string_view filter, std::string_view key) {
+  if (filter.size() < 2) {
+    return true;
+  }
+
+  const size_t bits = (filter.size() - 1) * 8;
+  const size_t probes = (uint8_t)filter.back();
+
+  uint32_t h = BloomHash(key);
+  const uint32_t delta = (h >> 17) | (h << 15);
+  for (size_t j = 0; j < probes; ++j) {
+    const uint32_t bit = h % bits;
+    if ((filter[bit / 8] & (1 << (bit % 8))) == 0) {
+      return false;
+    }
+    h += delta;
+  }
+  return true;
+}
+
+}  // namespace whirl::matrix::db
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <whirl/node/db/kv.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace whirl::matrix::db {
+
+// Bloom filter over table keys
+// Serialized representation: bit array + number of probes (last byte)
+
+class BloomFilter {
+ public:
+  // Build
+  static std::string Build(const std::vector<node::db::Key>& keys,
+                           size_t bits_per_key);
+
+  // Query
+  static bool MayContain(std::string_view filter, std::string_view key);
+};
+
+}  // namespace whirl::matrix::db
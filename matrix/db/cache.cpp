@@ -0,0 +1,46 @@
+#include <matrix/db/cache.hpp>
+
+namespace whirl::matrix::db {
+
+BlockRef BlockCache::Lookup(uint64_t table, size_t index) {
+  auto it = index_.find({table, index});
+  if (it == index_.end()) {
+    ++stats_->misses;
+    return nullptr;
+  }
+
+  ++stats_->hits;
+  // Move to front
+  items_.splice(items_.begin(), items_, it->second);
+  return it->second->block;
+}
+
+void BlockCache::Insert(uint64_t table, size_t index, BlockRef block,
+                        size_t bytes) {
+  if (bytes > capacity_) {
+    return;  // Do not flush the whole cache for a single block
+  }
+
+  CacheKey key{table, index};
+  if (index_.contains(key)) {
+    return;  // Concurrent miss on the same block
+  }
+
+  EvictTo(capacity_ - bytes);
+
+  items_.push_front({key, std::move(block), bytes});
+  index_.emplace(key, items_.begin());
+  used_ += bytes;
+}
+
+void BlockCache::EvictTo(size_t limit) {
+  while (used_ > limit) {
+    const Item& lru = items_.back();
+    used_ -= lru.bytes;
+    index_.erase(lru.key);
+    items_.pop_back();
+    ++stats_->evictions;
+  }
+}
+
+}  // namespace whirl::matrix::db
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <matrix/db/table.hpp>
+#include <matrix/db/stats.hpp>
+
+#include <list>
+#include <map>
+#include <utility>
+
+namespace whirl::matrix::db {
+
+// LRU cache of decoded data blocks
+// Capacity is measured in on-disk block bytes
+
+class BlockCache {
+  // (table number, block index)
+  using CacheKey = std::pair<uint64_t, size_t>;
+
+  struct Item {
+    CacheKey key;
+    BlockRef block;
+    size_t bytes;
+  };
+
+  using Items = std::list<Item>;
+
+ public:
+  BlockCache(size_t capacity, BlockCacheStats* stats)
+      : capacity_(capacity), stats_(stats) {
+  }
+
+  // Returns nullptr on miss
+  BlockRef Lookup(uint64_t table, size_t index);
+
+  void Insert(uint64_t table, size_t index, BlockRef block, size_t bytes);
+
+  size_t UsedBytes() const {
+    return used_;
+  }
+
+ private:
+  void EvictTo(size_t limit);
+
+ private:
+  const size_t capacity_;
+  BlockCacheStats* stats_;
+
+  // Most recently used first
+  Items items_;
+  std::map<CacheKey, Items::iterator> index_;
+  size_t used_ = 0;
+};
+
+}  // namespace whirl::matrix::db
@@ -2,36 +2,97 @@
 
 #include <matrix/db/snapshot.hpp>
 
-#include <matrix/world/global/random.hpp>
+#include <matrix/server/runtime/filesystem.hpp>
+
 #include <matrix/world/global/log.hpp>
-#include <matrix/world/global/time_model.hpp>
+#include <matrix/world/global/time.hpp>
 
 #include <matrix/log/bytes.hpp>
 
+#include <persist/fs/io/file_writer.hpp>
+
+#include <muesli/serialize.hpp>
+
 #include <wheels/memory/view_of.hpp>
 #include <wheels/support/assert.hpp>
 
 #include <timber/log.hpp>
 
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <charconv>
+#include <set>
+
 using whirl::node::db::Key;
 using whirl::node::db::Value;
 using whirl::node::db::WriteBatch;
 
 namespace whirl::matrix::db {
 
-Database::Database(persist::fs::IFileSystem* fs)
+// Returns sorted numbers of files in `dir` matching {prefix}{number}{suffix}
+static std::vector<uint64_t> ListNumberedFiles(matrix::FS* fs,
+                                               const persist::fs::Path& dir,
+                                               std::string_view prefix,
+                                               std::string_view suffix) {
+  const std::string dir_prefix = fs->PathAppend(dir.Repr(), "");
+
+  std::vector<uint64_t> numbers;
+
+  for (const auto& path : fs->ListFiles(dir_prefix)) {
+    std::string_view name = path.Repr();
+    name.remove_prefix(dir_prefix.length());
+
+    if (!name.starts_with(prefix) || !name.ends_with(suffix)) {
+      continue;
+    }
+    name.remove_prefix(prefix.length());
+    name.remove_suffix(suffix.length());
+
+    uint64_t number;
+    auto [end, ec] =
+        std::from_chars(name.data(), name.data() + name.size(), number);
+    if (ec == std::errc{} && end == name.data() + name.size()) {
+      numbers.push_back(number);
+    }
+  }
+
+  std::sort(numbers.begin(), numbers.end());
+  return numbers;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+Database::Database(matrix::FS* fs, Options options, Stats* stats)
     : fs_(fs),
+      options_(options),
+      stats_(stats),
+      mem_table_(MakeMemTable(options_.mem_table)),
+      reader_(fs, options_.block_cache_bytes, &stats->block_cache),
+      tables_(std::make_shared<Version>()),
       logger_("Database", GetLogBackend()) {
 }
 
 void Database::Open(const std::string& directory) {
   dir_ = fs_->MakePath(directory);
 
-  auto wal_path = LogPath();
-  wal_.emplace(fs_, wal_path);
-  wal_->Open(ReplayWAL(wal_path));
+  const TimePoint start_time = GlobalNow();
+
+  LoadManifest();
+  size_t wal_offset = Recover();
+  RemoveObsoleteFiles();
+
+  wal_.emplace(fs_, LogPath(log_number_));
+  wal_->Open(wal_offset);
+
+  Jiffies replay_time = GlobalNow() - start_time;
 
-  PrepareSSTable();
+  auto& stats = stats_->replay;
+  ++stats.replays;
+  stats.last_time = replay_time;
+  stats.total_time = stats.total_time.Count() + replay_time.Count();
+
+  LOG_INFO("Database opened in {} jiffies", replay_time.Count());
 }
 
 void Database::Put(const Key& key, const Value& value) {
@@ -59,22 +120,21 @@ std::optional<Value> Database::TryGet(const Key& key) const {
 
   LOG_INFO("TryGet({})", key);
 
-  if (ThisServerTimeModel()->GetCacheMiss()) {
-    AccessSSTable();
+  MaybeValue value;
+  if (mem_table_->TryGet(key, value)) {
+    return value;
   }
-  return mem_table_.TryGet(key);
-}
 
-void Database::IteratorMove() {
-  if (ThisServerTimeModel()->IteratorCacheMiss()) {
-    AccessSSTable();
-  }
+  // Pin tables: concurrent flush / compaction can replace them
+  auto tables = tables_;
+  return LookupTables(*tables, key);
 }
 
 node::db::ISnapshotPtr Database::MakeSnapshot() {
   EnsureOpened();
   LOG_INFO("Make snapshot at version {}", version_);
-  return std::make_shared<Snapshot>(this, mem_table_.GetEntries(), version_);
+  return std::make_shared<Snapshot>(this, mem_table_->GetEntries(), tables_,
+                                    version_);
 }
 
 void Database::Write(WriteBatch batch) {
@@ -89,6 +149,14 @@ void Database::DoWrite(WriteBatch& batch) {
   wal_->Append(batch);
   ApplyToMemTable(batch);
   ++version_;
+  ++wal_records_;
+
+  if (mem_table_->ApproximateBytes() >= options_.memtable_bytes) {
+    FlushMemTable();
+  } else if (options_.checkpoint_interval > 0 &&
+             wal_records_ >= options_.checkpoint_interval) {
+    Checkpoint();
+  }
 }
 
 void Database::ApplyToMemTable(const node::db::WriteBatch& batch) {
@@ -96,60 +164,477 @@ void Database::ApplyToMemTable(const node::db::WriteBatch& batch) {
     switch (mut.type) {
       case node::db::MutationType::Put:
         LOG_INFO("Put('{}', '{}')", mut.key, log::FormatMessage(*mut.value));
-        mem_table_.Put(mut.key, *mut.value);
+        mem_table_->Put(mut.key, *mut.value);
         break;
       case node::db::MutationType::Delete:
         LOG_INFO("Delete('{}')", mut.key);
-        mem_table_.Delete(mut.key);
+        mem_table_->Delete(mut.key);
         break;
     }
   }
 }
 
-size_t Database::ReplayWAL(persist::fs::Path wal_path) {
-  mem_table_.Clear();
+// Recovery
 
-  LOG_INFO("Replaying WAL -> MemTable");
+size_t Database::Recover() {
+  mem_table_->Clear();
+
+  stats_->replay.last_checkpoint_entries = 0;
+
+  // Latest complete checkpoint taken after the last flush
+  auto checkpoints = ListNumberedFiles(fs_, *dir_, "checkpoint-", "");
+  for (auto it = checkpoints.rbegin(); it != checkpoints.rend(); ++it) {
+    if (*it < log_number_) {
+      break;  // Stale
+    }
+    if (LoadCheckpoint(*it)) {
+      // WAL with the same number continues checkpoint
+      log_number_ = *it;
+      break;
+    }
+  }
+
+  // Checkpoints are not recorded in manifest
+  next_file_number_ = std::max(next_file_number_, log_number_ + 1);
+
+  size_t wal_offset = ReplayWAL(LogPath(log_number_));
+
+  stats_->replay.last_wal_records = wal_records_;
+  stats_->replay.total_wal_records += wal_records_;
+
+  LOG_INFO("MemTable populated");
+
+  return wal_offset;
+}
+
+bool Database::LoadCheckpoint(uint64_t number) {
+  persist::log::LogReader checkpoint_reader(fs_, CheckpointPath(number));
+
+  auto record = checkpoint_reader.ReadNext();
+  if (!record.has_value()) {
+    return false;  // Crashed while writing
+  }
+
+  auto checkpoint = muesli::Deserialize<CheckpointRecord>(*record);
+
+  LOG_INFO("Load checkpoint #{} -> MemTable: {} entries, version {}", number,
+           checkpoint.entries.size(), checkpoint.version);
+
+  for (auto& entry : checkpoint.entries) {
+    if (entry.tombstone) {
+      mem_table_->Delete(std::move(entry.key));
+    } else {
+      mem_table_->Put(std::move(entry.key), std::move(entry.value));
+    }
+  }
+  version_ = checkpoint.version;
+
+  stats_->replay.last_checkpoint_entries = checkpoint.entries.size();
+
+  return true;
+}
+
+size_t Database::ReplayWAL(persist::fs::Path wal_path) {
+  wal_records_ = 0;
 
   if (!fs_->Exists(wal_path)) {
     return 0;
   }
 
-  version_ = 0;
+  LOG_INFO("Replaying WAL -> MemTable");
 
   WALReader wal_reader(fs_, wal_path);
 
+  // WAL contains only mutations made after the last checkpoint / flush
   while (auto batch = wal_reader.ReadNext()) {
     ApplyToMemTable(*batch);
     ++version_;
+    ++wal_records_;
   }
 
-  LOG_INFO("MemTable populated");
-
   return wal_reader.WriterOffset();
 }
 
-// Emulate read latency
+// Read path
+
+std::vector<SortedRun> Database::MakeRuns(const Version& version) const {
+  std::vector<SortedRun> runs;
+
+  // Newest first
+  for (const auto& table : version.levels[0]) {
+    runs.emplace_back(std::vector<TableRef>{table}, &reader_);
+  }
+  for (size_t level = 1; level < kNumLevels; ++level) {
+    if (!version.levels[level].empty()) {
+      runs.emplace_back(version.levels[level], &reader_);
+    }
+  }
+
+  return runs;
+}
+
+std::optional<Value> Database::LookupTables(const Version& version,
+                                            const Key& key) const {
+  MaybeValue value;
+  for (const auto& run : MakeRuns(version)) {
+    if (run.Get(key, value)) {
+      return value;
+    }
+  }
+  return std::nullopt;
+}
+
+// Write path
+
+void Database::FlushMemTable() {
+  if (mem_table_->IsEmpty()) {
+    return;
+  }
+
+  TableBuilder builder(options_);
+  mem_table_->ForEach([&builder](const Key& key, const MaybeValue& value) {
+    builder.Add(key, value);
+  });
+
+  auto version = std::make_shared<Version>(*tables_);
+
+  auto table = WriteTable(builder, /*level=*/0);
+
+  LOG_INFO("Flush MemTable -> L0 table #{} ({} entries)", table->Number(),
+           table->Info().entries);
 
-void Database::PrepareSSTable() {
-  auto sstable_path = SSTablePath();
-  if (!fs_->Exists(sstable_path)) {
-    fs_->Create(sstable_path).ExpectOk();
+  auto& l0 = version->levels[0];
+  l0.insert(l0.begin(), table);
 
-    persist::fs::FileWriter writer(fs_, sstable_path);
+  std::vector<TableRef> obsolete;
+  MaybeCompact(*version, obsolete);
+
+  // Flushed mutations are durable in tables now
+  const uint64_t prev_log_number = log_number_;
+  SwitchLog(next_file_number_++);
+
+  WriteManifest(*version);
+
+  RemoveLog(prev_log_number);
+  mem_table_->Clear();
+
+  tables_ = version;
+
+  // Files will be removed when pinning snapshots are gone
+  for (const auto& table : obsolete) {
+    table->MarkObsolete();
+  }
+}
+
+TableRef Database::WriteTable(TableBuilder& builder, size_t level) {
+  TableInfo info;
+  TableMeta meta;
+
+  auto image = builder.Finish(info, meta);
+
+  info.number = next_file_number_++;
+  info.level = level;
+
+  auto path = TablePath(info.number);
+
+  fs_->Create(path).ExpectOk();
+
+  {
+    persist::fs::FileWriter writer(fs_, path);
     writer.Open().ExpectOk();
-    writer.Write(wheels::ViewOf("data")).ExpectOk();
+    writer.Write(wheels::ViewOf(image)).ExpectOk();
   }
+
+  return std::make_shared<Table>(fs_, path, std::move(info), std::move(meta));
 }
 
-void Database::AccessSSTable() const {
-  LOG_INFO("Cache miss, access SSTable on disk");
+// Checkpoints
+
+void Database::Checkpoint() {
+  const uint64_t number = next_file_number_++;
+
+  CheckpointRecord checkpoint{version_, {}};
+  mem_table_->ForEach([&checkpoint](const Key& key, const MaybeValue& value) {
+    checkpoint.entries.push_back(
+        {key, !value.has_value(), value.value_or(Value{})});
+  });
+
+  {
+    persist::log::LogWriter checkpoint_writer(fs_, CheckpointPath(number));
+    checkpoint_writer.Open(0).ExpectOk();
+    auto record = muesli::Serialize(checkpoint);
+    checkpoint_writer.Append(wheels::ViewOf(record)).ExpectOk();
+  }
 
-  persist::fs::FileReader reader(fs_, SSTablePath());
-  reader.Open().ExpectOk();
+  LOG_INFO("Checkpoint #{}: {} entries, version {}", number,
+           checkpoint.entries.size(), version_);
+
+  // Checkpoint is complete, WAL prefix is not needed
+  const uint64_t prev_log_number = log_number_;
+  SwitchLog(number);
+  RemoveLog(prev_log_number);
+}
+
+void Database::SwitchLog(uint64_t number) {
+  log_number_ = number;
+  wal_records_ = 0;
+
+  wal_.emplace(fs_, LogPath(number));
+  wal_->Open(0);
+}
+
+void Database::RemoveLog(uint64_t number) {
+  for (const auto& path : {LogPath(number), CheckpointPath(number)}) {
+    if (fs_->Exists(path)) {
+      fs_->Unlink(path).ExpectOk();
+    }
+  }
+}
+
+// Compaction
+
+void Database::MaybeCompact(Version& version,
+                            std::vector<TableRef>& obsolete) {
+  size_t level;
+  std::vector<TableRef> inputs;
+
+  while (PickCompaction(version, level, inputs)) {
+    Compact(version, level, inputs, obsolete);
+  }
+}
+
+bool Database::PickCompaction(const Version& version, size_t& level,
+                              std::vector<TableRef>& inputs) {
+  // L0 -> L1: all L0 tables, their key ranges overlap
+  if (version.levels[0].size() >= options_.l0_compaction_trigger) {
+    level = 0;
+    inputs = version.levels[0];
+    return true;
+  }
+
+  // Li -> Li+1: one table, round-robin over key space
+  size_t max_bytes = options_.l1_max_bytes;
+  for (size_t i = 1; i + 1 < kNumLevels; ++i) {
+    if (version.LevelBytes(i) > max_bytes) {
+      const auto& tables = version.levels[i];
+
+      auto it = std::find_if(tables.begin(), tables.end(),
+                             [this, i](const TableRef& table) {
+                               return compact_pointers_[i] < table->Smallest();
+                             });
+      if (it == tables.end()) {
+        it = tables.begin();  // Wrap around
+      }
+
+      compact_pointers_[i] = (*it)->Largest();
+
+      level = i;
+      inputs = {*it};
+      return true;
+    }
+    max_bytes *= options_.level_size_multiplier;
+  }
+
+  return false;
+}
+
+static void RemoveTables(std::vector<TableRef>& tables,
+                         const std::vector<TableRef>& victims) {
+  std::set<uint64_t> numbers;
+  for (const auto& victim : victims) {
+    numbers.insert(victim->Number());
+  }
+
+  std::erase_if(tables, [&numbers](const TableRef& table) {
+    return numbers.count(table->Number()) > 0;
+  });
+}
+
+void Database::Compact(Version& version, size_t level,
+                       const std::vector<TableRef>& inputs,
+                       std::vector<TableRef>& obsolete) {
+  const size_t output_level = level + 1;
+
+  Key smallest = inputs.front()->Smallest();
+  Key largest = inputs.front()->Largest();
+  for (const auto& table : inputs) {
+    smallest = std::min(smallest, table->Smallest());
+    largest = std::max(largest, table->Largest());
+  }
+
+  auto overlapping = version.Overlapping(output_level, smallest, largest);
+
+  LOG_INFO("Compact {} table(s) from L{} with {} table(s) from L{}",
+           inputs.size(), level, overlapping.size(), output_level);
+
+  // Merge from oldest to newest: newer entries shadow older ones
+
+  Entries merged;
+
+  for (const auto& table : overlapping) {
+    for (auto& entry : reader_.ReadAll(*table)) {
+      merged.insert_or_assign(std::move(entry.key), entry.Get());
+    }
+  }
+
+  // L0 tables are ordered from newest to oldest
+  for (auto it = inputs.rbegin(); it != inputs.rend(); ++it) {
+    for (auto& entry : reader_.ReadAll(**it)) {
+      merged.insert_or_assign(std::move(entry.key), entry.Get());
+    }
+  }
+
+  // Write output tables
+
+  std::vector<TableRef> outputs;
+  std::optional<TableBuilder> builder;
+  builder.emplace(options_);
+
+  for (const auto& [key, value] : merged) {
+    if (!value.has_value() && version.IsBaseLevelFor(output_level, key)) {
+      continue;  // Drop tombstone, nothing to shadow
+    }
+
+    builder->Add(key, value);
+
+    if (builder->EstimatedSize() >= options_.table_bytes) {
+      outputs.push_back(WriteTable(*builder, output_level));
+      builder.emplace(options_);
+    }
+  }
+
+  if (!builder->IsEmpty()) {
+    outputs.push_back(WriteTable(*builder, output_level));
+  }
+
+  // Install outputs
+
+  RemoveTables(version.levels[level], inputs);
+  RemoveTables(version.levels[output_level], overlapping);
+
+  auto& tables = version.levels[output_level];
+  tables.insert(tables.end(), outputs.begin(), outputs.end());
+  std::sort(tables.begin(), tables.end(),
+            [](const TableRef& lhs, const TableRef& rhs) {
+              return lhs->Smallest() < rhs->Smallest();
+            });
+
+  obsolete.insert(obsolete.end(), inputs.begin(), inputs.end());
+  obsolete.insert(obsolete.end(), overlapping.begin(), overlapping.end());
+}
+
+// Manifest
+
+void Database::LoadManifest() {
+  auto version = std::make_shared<Version>();
+
+  auto manifests = ListNumberedFiles(fs_, *dir_, "manifest-", "");
+
+  // Latest complete manifest wins
+  for (auto it = manifests.rbegin(); it != manifests.rend(); ++it) {
+    persist::log::LogReader manifest_reader(fs_, ManifestPath(*it));
+
+    auto record = manifest_reader.ReadNext();
+    if (!record.has_value()) {
+      continue;  // Crashed while writing
+    }
+
+    auto manifest = muesli::Deserialize<ManifestRecord>(*record);
+
+    manifest_number_ = *it;
+    next_file_number_ = manifest.next_file_number;
+    log_number_ = manifest.log_number;
+    version_ = manifest.version;
+
+    for (auto& info : manifest.tables) {
+      size_t level = info.level;
+      auto path = TablePath(info.number);
+      version->levels[level].push_back(reader_.Open(path, std::move(info)));
+    }
+
+    LOG_INFO("Manifest #{} loaded: {} tables, version {}", manifest_number_,
+             manifest.tables.size(), version_);
+    break;
+  }
+
+  tables_ = version;
+}
+
+void Database::WriteManifest(const Version& version) {
+  ManifestRecord manifest{next_file_number_, log_number_, version_, {}};
+  for (const auto& level : version.levels) {
+    for (const auto& table : level) {
+      manifest.tables.push_back(table->Info());
+    }
+  }
+
+  const uint64_t number = manifest_number_ + 1;
+
+  {
+    persist::log::LogWriter manifest_writer(fs_, ManifestPath(number));
+    manifest_writer.Open(0).ExpectOk();
+    auto record = muesli::Serialize(manifest);
+    manifest_writer.Append(wheels::ViewOf(record)).ExpectOk();
+  }
+
+  // New manifest is complete, previous one is not needed
+  if (manifest_number_ > 0) {
+    fs_->Unlink(ManifestPath(manifest_number_)).ExpectOk();
+  }
+  manifest_number_ = number;
+}
+
+void Database::RemoveObsoleteFiles() {
+  std::set<uint64_t> live;
+  for (const auto& level : tables_->levels) {
+    for (const auto& table : level) {
+      live.insert(table->Number());
+    }
+  }
+
+  // Leftovers of interrupted flushes / compactions
+  for (uint64_t number : ListNumberedFiles(fs_, *dir_, "", ".sst")) {
+    if (live.count(number) == 0) {
+      LOG_INFO("Remove obsolete table #{}", number);
+      fs_->Unlink(TablePath(number)).ExpectOk();
+    }
+  }
+
+  for (uint64_t number : ListNumberedFiles(fs_, *dir_, "manifest-", "")) {
+    if (number != manifest_number_) {
+      fs_->Unlink(ManifestPath(number)).ExpectOk();
+    }
+  }
+
+  // Logs and checkpoints replaced by the recovered one
+  for (uint64_t number : ListNumberedFiles(fs_, *dir_, "wal-", "")) {
+    if (number != log_number_) {
+      fs_->Unlink(LogPath(number)).ExpectOk();
+    }
+  }
+  for (uint64_t number : ListNumberedFiles(fs_, *dir_, "checkpoint-", "")) {
+    if (number != log_number_) {
+      fs_->Unlink(CheckpointPath(number)).ExpectOk();
+    }
+  }
+}
+
+// Paths
+
+persist::fs::Path Database::LogPath(uint64_t number) const {
+  return *dir_ / fmt::format("wal-{}", number);
+}
+
+persist::fs::Path Database::CheckpointPath(uint64_t number) const {
+  return *dir_ / fmt::format("checkpoint-{}", number);
+}
+
+persist::fs::Path Database::TablePath(uint64_t number) const {
+  return *dir_ / fmt::format("{}.sst", number);
+}
 
-  char buf[128];
-  reader.ReadSome(wheels::MutViewOf(buf)).ExpectOk();
+persist::fs::Path Database::ManifestPath(uint64_t number) const {
+  return *dir_ / fmt::format("manifest-{}", number);
 }
 
 void Database::EnsureOpened() const {
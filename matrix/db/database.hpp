@@ -5,22 +5,43 @@
 
 #include <persist/fs/fs.hpp>
 
+#include <matrix/db/options.hpp>
+#include <matrix/db/stats.hpp>
 #include <matrix/db/mem_table.hpp>
 #include <matrix/db/wal.hpp>
+#include <matrix/db/table.hpp>
+#include <matrix/db/reader.hpp>
+#include <matrix/db/run.hpp>
+#include <matrix/db/version.hpp>
 
 #include <timber/logger.hpp>
 
 #include <await/fibers/sync/mutex.hpp>
 
+#include <array>
+
+namespace whirl::matrix {
+
+class FS;
+
+}  // namespace whirl::matrix
+
 namespace whirl::matrix::db {
 
 // Implemented in userspace
 
+// Log-structured merge tree:
+// WAL + MemTable -> L0 tables -> L1 -> ... -> L{kNumLevels - 1}
+
+// MemTable is periodically checkpointed, so Open replays
+// the latest checkpoint + WAL tail
+
 class Database : public node::db::IDatabase {
   friend class Iterator;
+  friend class Snapshot;
 
  public:
-  explicit Database(persist::fs::IFileSystem* fs);
+  Database(matrix::FS* fs, Options options, Stats* stats);
 
   void Open(const std::string& directory) override;
 
@@ -42,39 +63,81 @@ class Database : public node::db::IDatabase {
   void DoWrite(node::db::WriteBatch& batch);
   void ApplyToMemTable(const node::db::WriteBatch& batch);
 
+  // Recovery
+
   // Returns start offset for log writer
+  size_t Recover();
+  bool LoadCheckpoint(uint64_t number);
   size_t ReplayWAL(persist::fs::Path wal_path);
 
-  void IteratorMove();
+  // Read path
+
+  std::vector<SortedRun> MakeRuns(const Version& version) const;
+  std::optional<node::db::Value> LookupTables(const Version& version,
+                                              const node::db::Key& key) const;
 
-  persist::fs::Path LogPath() const {
-    return *dir_ / "wal";
-  }
+  // Write path
 
-  // Emulate read latency
+  void FlushMemTable();
+  TableRef WriteTable(TableBuilder& builder, size_t level);
 
-  persist::fs::Path SSTablePath() const {
-    return *dir_ / "sstable";
-  }
+  void Checkpoint();
 
-  void AccessSSTable() const;
-  void PrepareSSTable();
+  // Start new WAL
+  void SwitchLog(uint64_t number);
+  // Remove WAL and checkpoint
+  void RemoveLog(uint64_t number);
+
+  // Compaction
+
+  void MaybeCompact(Version& version, std::vector<TableRef>& obsolete);
+  bool PickCompaction(const Version& version, size_t& level,
+                      std::vector<TableRef>& inputs);
+  void Compact(Version& version, size_t level,
+               const std::vector<TableRef>& inputs,
+               std::vector<TableRef>& obsolete);
+
+  // Manifest
+
+  void LoadManifest();
+  void WriteManifest(const Version& version);
+  void RemoveObsoleteFiles();
+
+  // Paths
+
+  persist::fs::Path LogPath(uint64_t number) const;
+  persist::fs::Path CheckpointPath(uint64_t number) const;
+  persist::fs::Path TablePath(uint64_t number) const;
+  persist::fs::Path ManifestPath(uint64_t number) const;
 
  private:
   void EnsureOpened() const;
 
  private:
-  persist::fs::IFileSystem* fs_;
+  matrix::FS* fs_;
+  const Options options_;
+  Stats* stats_;
 
   std::optional<persist::fs::Path> dir_;
 
-  MemTable mem_table_;
+  IMemTablePtr mem_table_;
   std::optional<WALWriter> wal_;
+  uint64_t log_number_ = 0;
+  // Since last checkpoint / flush
+  size_t wal_records_ = 0;
   await::fibers::Mutex write_mutex_;
 
   // Incremented on each (batch) mutation
   uint64_t version_ = 0;
 
+  // Tables
+  mutable TableReader reader_;
+  VersionRef tables_;
+  uint64_t next_file_number_ = 1;
+  uint64_t manifest_number_ = 0;
+  // Round-robin compaction
+  std::array<node::db::Key, kNumLevels> compact_pointers_;
+
   mutable timber::Logger logger_;
 };
 
@@ -3,9 +3,13 @@
 #include <whirl/node/db/kv.hpp>
 
 #include <map>
+#include <optional>
 
 namespace whirl::matrix::db {
 
-using Entries = std::map<node::db::Key, node::db::Value>;
+// Value or tombstone (std::nullopt)
+using MaybeValue = std::optional<node::db::Value>;
+
+using Entries = std::map<node::db::Key, MaybeValue>;
 
 }  // namespace whirl::matrix::db
@@ -6,52 +6,45 @@
 
 namespace whirl::matrix::db {
 
+static TableEntry ToTableEntry(const Entries::value_type& entry) {
+  const auto& [key, value] = entry;
+  if (value.has_value()) {
+    return {key, false, *value};
+  } else {
+    return {key, true, {}};
+  }
+}
+
 Iterator::Iterator(SnapshotRef snapshot)
-  : snapshot_(snapshot),
-    entries_(snapshot->GetEntries()) {
+    : snapshot_(snapshot),
+      mem_table_(snapshot->GetMemTable()),
+      runs_(snapshot->Db()->MakeRuns(*snapshot->GetTables())) {
+  for (const auto& run : runs_) {
+    run_cursors_.emplace_back(&run);
+  }
   SeekToFirst();
 }
 
 node::db::KeyView Iterator::Key() const {
   EnsureValid();
-  return it_->first;
+  return key_;
 }
 
 node::db::ValueView Iterator::Value() const {
   EnsureValid();
-  return it_->second;
+  return value_;
 }
 
 void Iterator::SeekToFirst() {
-  if (entries_.empty()) {
-    valid_ = false;
-    return;
-  }
-
-  valid_ = true;
-  it_ = entries_.begin();
-  Move();
+  SeekForward(/*target=*/"", /*inclusive=*/true);
 }
 
 void Iterator::SeekToLast() {
-  if (entries_.empty()) {
-    valid_ = false;
-    return;
-  }
-
-  valid_ = true;
-  it_ = std::prev(entries_.end());
-  Move();
+  SeekBackward(/*target=*/"", /*unbounded=*/true);
 }
 
 void Iterator::Seek(const node::db::Key& target) {
-  it_ = entries_.lower_bound(target);
-  if (it_ != entries_.end()) {
-    valid_ = true;
-    Move();
-  } else {
-    valid_ = false;
-  }
+  SeekForward(target, /*inclusive=*/true);
 }
 
 bool Iterator::Valid() const {
@@ -60,26 +53,115 @@ bool Iterator::Valid() const {
 
 void Iterator::Next() {
   EnsureValid();
-  ++it_;
-  if (it_ != entries_.end()) {
-    Move();
+  if (forward_) {
+    MergeForward();
   } else {
-    valid_ = false;
+    // Direction change
+    SeekForward(key_, /*inclusive=*/false);
   }
 }
 
 void Iterator::Prev() {
   EnsureValid();
-  if (it_ != entries_.begin()) {
-    --it_;
-    Move();
-  } else {
-    valid_ = false;
+  SeekBackward(key_, /*unbounded=*/false);
+}
+
+void Iterator::SeekForward(const node::db::Key& target, bool inclusive) {
+  mem_cursor_ = inclusive ? mem_table_.lower_bound(target)
+                          : mem_table_.upper_bound(target);
+  for (auto& cursor : run_cursors_) {
+    cursor.Seek(target, inclusive);
+  }
+  forward_ = true;
+
+  MergeForward();
+}
+
+void Iterator::MergeForward() {
+  while (true) {
+    std::optional<TableEntry> next;
+
+    // Sources are ordered from newest to oldest,
+    // so the newest version wins on equal keys
+    if (mem_cursor_ != mem_table_.end()) {
+      next = ToTableEntry(*mem_cursor_);
+    }
+    for (const auto& cursor : run_cursors_) {
+      if (cursor.Valid() &&
+          (!next.has_value() || cursor.Entry().key < next->key)) {
+        next = cursor.Entry();
+      }
+    }
+
+    if (!next.has_value()) {
+      valid_ = false;
+      return;
+    }
+
+    // Step over all versions of the key
+    if (mem_cursor_ != mem_table_.end() && mem_cursor_->first == next->key) {
+      ++mem_cursor_;
+    }
+    for (auto& cursor : run_cursors_) {
+      if (cursor.Valid() && cursor.Entry().key == next->key) {
+        cursor.Next();
+      }
+    }
+
+    if (next->tombstone) {
+      continue;  // Skip deleted key
+    }
+
+    valid_ = true;
+    key_ = std::move(next->key);
+    value_ = std::move(next->value);
+    return;
+  }
+}
+
+void Iterator::SeekBackward(node::db::Key target, bool unbounded) {
+  forward_ = false;
+
+  while (true) {
+    std::optional<TableEntry> prev;
+
+    auto consider = [&prev](std::optional<TableEntry> entry) {
+      if (entry.has_value() && (!prev.has_value() || prev->key < entry->key)) {
+        prev = std::move(entry);
+      }
+    };
+
+    consider(MemBefore(target, unbounded));
+    for (const auto& run : runs_) {
+      consider(unbounded ? run.Last() : run.Before(target));
+    }
+
+    if (!prev.has_value()) {
+      valid_ = false;
+      return;
+    }
+
+    if (prev->tombstone) {
+      // Skip deleted key
+      target = prev->key;
+      unbounded = false;
+      continue;
+    }
+
+    valid_ = true;
+    key_ = std::move(prev->key);
+    value_ = std::move(prev->value);
+    return;
   }
 }
 
-void Iterator::Move() {
-  snapshot_->Db()->IteratorMove();
+std::optional<TableEntry> Iterator::MemBefore(const node::db::Key& target,
+                                              bool unbounded) const {
+  auto it = unbounded ? mem_table_.end() : mem_table_.lower_bound(target);
+  if (it == mem_table_.begin()) {
+    return std::nullopt;
+  }
+  return ToTableEntry(*std::prev(it));
 }
 
 void Iterator::EnsureValid() const {
@@ -4,10 +4,19 @@
 #include <whirl/node/db/snapshot.hpp>
 
 #include <matrix/db/entries.hpp>
+#include <matrix/db/run.hpp>
 #include <matrix/db/snapshot.hpp>
 
+#include <optional>
+#include <vector>
+
 namespace whirl::matrix::db {
 
+// Merges snapshot memtable with pinned sorted runs
+// Newest version of key wins, tombstones are skipped
+// Forward iteration keeps a cursor per source, backward iteration
+// re-seeks sources on every step
+
 class Iterator : public node::db::IIterator {
  public:
   explicit Iterator(SnapshotRef snapshot);
@@ -29,16 +38,32 @@ class Iterator : public node::db::IIterator {
  private:
   void EnsureValid() const;
 
-  // Access new key
-  void Move();
+  // Smallest key >= (inclusive) or > `target`
+  void SeekForward(const node::db::Key& target, bool inclusive);
+  // Takes smallest key from positioned cursors
+  void MergeForward();
+  // Largest key < `target` or last key (unbounded)
+  void SeekBackward(node::db::Key target, bool unbounded);
+
+  // MemTable access
+  std::optional<TableEntry> MemBefore(const node::db::Key& target,
+                                      bool unbounded) const;
 
  private:
   SnapshotRef snapshot_;
 
-  const Entries& entries_;
+  const Entries& mem_table_;
+  // Newest first
+  std::vector<SortedRun> runs_;
+
+  // Forward cursors, positioned after current key
+  bool forward_ = false;
+  Entries::const_iterator mem_cursor_;
+  std::vector<RunCursor> run_cursors_;
 
   bool valid_ = false;
-  Entries::const_iterator it_;
+  node::db::Key key_;
+  node::db::Value value_;
 };
 
 }  // namespace whirl::matrix::db
@@ -0,0 +1,23 @@
+#include <matrix/db/mem_table.hpp>
+
+#include <matrix/db/mem_tables/map.hpp>
+#include <matrix/db/mem_tables/hash.hpp>
+#include <matrix/db/mem_tables/skip_list.hpp>
+
+#include <wheels/support/assert.hpp>
+
+namespace whirl::matrix::db {
+
+IMemTablePtr MakeMemTable(MemTableKind kind) {
+  switch (kind) {
+    case MemTableKind::Map:
+      return MakeMapMemTable();
+    case MemTableKind::Hash:
+      return MakeHashMemTable();
+    case MemTableKind::SkipList:
+      return MakeSkipListMemTable();
+  }
+  WHEELS_PANIC("Unknown memtable kind");
+}
+
+}  // namespace whirl::matrix::db
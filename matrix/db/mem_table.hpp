@@ -1,44 +1,52 @@
 #pragma once
 
 #include <matrix/db/entries.hpp>
+#include <matrix/db/options.hpp>
 
+#include <functional>
+#include <memory>
 #include <optional>
 
 namespace whirl::matrix::db {
 
 // Sorted in-memory string -> string mapping
+// Deletions are stored as tombstones, they shadow older tables
 
-class MemTable {
- public:
-  MemTable() = default;
+struct IMemTable {
+  using EntryVisitor =
+      std::function<void(const node::db::Key& key, const MaybeValue& value)>;
 
-  void Put(node::db::Key key, node::db::Value value) {
-    entries_.insert_or_assign(key, value);
-  }
+  virtual ~IMemTable() = default;
 
-  std::optional<node::db::Value> TryGet(node::db::Key key) const {
-    auto it = entries_.find(key);
-    if (it != entries_.end()) {
-      return it->second;
-    } else {
-      return std::nullopt;
-    }
-  }
+  virtual void Put(node::db::Key key, node::db::Value value) = 0;
+  virtual void Delete(node::db::Key key) = 0;
 
-  void Delete(node::db::Key key) {
-    entries_.erase(key);
-  }
+  // false - key not found
+  // `value` = std::nullopt - key deleted
+  virtual bool TryGet(const node::db::Key& key, MaybeValue& value) const = 0;
 
-  void Clear() {
-    entries_.clear();
-  }
+  virtual void Clear() = 0;
 
-  const Entries& GetEntries() const {
-    return entries_;
-  }
+  virtual bool IsEmpty() const = 0;
 
- private:
-  Entries entries_;
+  // Total size of mutations applied since last Clear
+  virtual size_t ApproximateBytes() const = 0;
+
+  // Visits entries in key order
+  // Context: flush, checkpoint, snapshot
+  virtual void ForEach(const EntryVisitor& visitor) const = 0;
+
+  Entries GetEntries() const {
+    Entries entries;
+    ForEach([&entries](const node::db::Key& key, const MaybeValue& value) {
+      entries.emplace_hint(entries.end(), key, value);
+    });
+    return entries;
+  }
 };
 
+using IMemTablePtr = std::unique_ptr<IMemTable>;
+
+IMemTablePtr MakeMemTable(MemTableKind kind);
+
 }  // namespace whirl::matrix::db
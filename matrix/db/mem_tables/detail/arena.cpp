@@ -0,0 +1,72 @@
+#include <matrix/db/mem_tables/detail/arena.hpp>
+
+#include <cstdint>
+
+namespace whirl::matrix::db {
+
+Arena::~Arena() {
+  Reset();
+  for (char* block : blocks_) {
+    delete[] block;
+  }
+}
+
+char* Arena::Allocate(size_t bytes) {
+  if (bytes <= remaining_) {
+    char* result = ptr_;
+    ptr_ += bytes;
+    remaining_ -= bytes;
+    return result;
+  }
+  return AllocateFallback(bytes);
+}
+
+char* Arena::AllocateAligned(size_t bytes) {
+  static const size_t kAlign = alignof(void*);
+
+  size_t mod = reinterpret_cast<uintptr_t>(ptr_) & (kAlign - 1);
+  size_t slop = (mod == 0) ? 0 : kAlign - mod;
+
+  if (bytes + slop <= remaining_) {
+    char* result = ptr_ + slop;
+    ptr_ += bytes + slop;
+    remaining_ -= bytes + slop;
+    return result;
+  }
+  // Blocks are always aligned
+  return AllocateFallback(bytes);
+}
+
+char* Arena::AllocateFallback(size_t bytes) {
+  if (bytes > kBlockSize / 4) {
+    // Do not waste the rest of the current block
+    char* block = new char[bytes];
+    large_blocks_.push_back(block);
+    return block;
+  }
+
+  if (next_block_ == blocks_.size()) {
+    blocks_.push_back(new char[kBlockSize]);
+  }
+
+  ptr_ = blocks_[next_block_++];
+  remaining_ = kBlockSize;
+
+  char* result = ptr_;
+  ptr_ += bytes;
+  remaining_ -= bytes;
+  return result;
+}
+
+void Arena::Reset() {
+  for (char* block : large_blocks_) {
+    delete[] block;
+  }
+  large_blocks_.clear();
+
+  ptr_ = nullptr;
+  remaining_ = 0;
+  next_block_ = 0;
+}
+
+}  // namespace whirl::matrix::db
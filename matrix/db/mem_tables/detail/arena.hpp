@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdlib>
+#include <vector>
+
+namespace whirl::matrix::db {
+
+// Bump allocator, memory is released all at once
+// Blocks are retained on Reset and reused by next allocations
+
+class Arena {
+ public:
+  static const size_t kBlockSize = 4096;
+
+  Arena() = default;
+  ~Arena();
+
+  // Non-copyable
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  char* Allocate(size_t bytes);
+  // Aligned for pointers
+  char* AllocateAligned(size_t bytes);
+
+  // Invalidates all allocations, O(1) for regular blocks
+  void Reset();
+
+ private:
+  char* AllocateFallback(size_t bytes);
+
+ private:
+  // Current block
+  char* ptr_ = nullptr;
+  size_t remaining_ = 0;
+
+  std::vector<char*> blocks_;
+  size_t next_block_ = 0;
+
+  // Dedicated blocks for large allocations
+  std::vector<char*> large_blocks_;
+};
+
+}  // namespace whirl::matrix::db
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <matrix/db/mem_tables/detail/arena.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace whirl::matrix::db {
+
+// Immutable string, small strings are stored inline,
+// bytes of larger ones are copied to arena
+
+class ArenaString {
+  static const size_t kInlineCapacity = 12;
+
+ public:
+  ArenaString() = default;
+
+  ArenaString(std::string_view str, Arena& arena) : size_(str.size()) {
+    if (size_ <= kInlineCapacity) {
+      std::memcpy(inline_, str.data(), size_);
+    } else {
+      char* bytes = arena.Allocate(size_);
+      std::memcpy(bytes, str.data(), size_);
+      std::memcpy(inline_, &bytes, sizeof(bytes));
+    }
+  }
+
+  std::string_view View() const {
+    if (size_ <= kInlineCapacity) {
+      return {inline_, size_};
+    }
+    const char* bytes;
+    std::memcpy(&bytes, inline_, sizeof(bytes));
+    return {bytes, size_};
+  }
+
+ private:
+  uint32_t size_ = 0;
+  // Bytes or pointer to arena
+  char inline_[kInlineCapacity];
+};
+
+static_assert(sizeof(ArenaString) == 16);
+
+}  // namespace whirl::matrix::db
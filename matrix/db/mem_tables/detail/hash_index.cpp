@@ -0,0 +1,56 @@
+#include <matrix/db/mem_tables/detail/hash_index.hpp>
+
+namespace whirl::matrix::db {
+
+SkipList::Node* HashIndex::Find(std::string_view key) const {
+  const size_t hash = Hash(key);
+  const size_t mask = slots_.size() - 1;
+
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    const Slot& slot = slots_[i];
+    if (slot.node == nullptr) {
+      return nullptr;
+    }
+    if (slot.hash == hash && slot.node->key.View() == key) {
+      return slot.node;
+    }
+  }
+}
+
+void HashIndex::Insert(SkipList::Node* node) {
+  // Load factor <= 1/2
+  if (2 * (size_ + 1) > slots_.size()) {
+    Grow();
+  }
+  Place(Hash(node->key.View()), node);
+  ++size_;
+}
+
+void HashIndex::Reset(size_t capacity) {
+  slots_.assign(capacity, Slot{0, nullptr});
+  size_ = 0;
+}
+
+void HashIndex::Place(size_t hash, SkipList::Node* node) {
+  const size_t mask = slots_.size() - 1;
+
+  size_t i = hash & mask;
+  while (slots_[i].node != nullptr) {
+    i = (i + 1) & mask;
+  }
+  slots_[i] = {hash, node};
+}
+
+void HashIndex::Grow() {
+  std::vector<Slot> slots;
+  slots.swap(slots_);
+
+  slots_.assign(slots.size() * 2, Slot{0, nullptr});
+  for (const Slot& slot : slots) {
+    if (slot.node != nullptr) {
+      Place(slot.hash, slot.node);
+    }
+  }
+}
+
+}  // namespace whirl::matrix::db
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <matrix/db/mem_tables/detail/skip_list.hpp>
+
+#include <string_view>
+#include <vector>
+
+namespace whirl::matrix::db {
+
+// Open addressing (linear probing) index: key -> skiplist node
+// Insert-only, nodes are owned by skiplist
+
+class HashIndex {
+  struct Slot {
+    size_t hash;
+    SkipList::Node* node;  // nullptr - empty slot
+  };
+
+ public:
+  HashIndex() {
+    Reset(kInitialCapacity);
+  }
+
+  SkipList::Node* Find(std::string_view key) const;
+
+  // Precondition: key of `node` is not in index
+  void Insert(SkipList::Node* node);
+
+  void Clear() {
+    Reset(kInitialCapacity);
+  }
+
+ private:
+  static const size_t kInitialCapacity = 64;
+
+  static size_t Hash(std::string_view key) {
+    return std::hash<std::string_view>{}(key);
+  }
+
+  void Reset(size_t capacity);
+  void Place(size_t hash, SkipList::Node* node);
+  void Grow();
+
+ private:
+  // Capacity is a power of two
+  std::vector<Slot> slots_;
+  size_t size_ = 0;
+};
+
+}  // namespace whirl::matrix::db
@@ -0,0 +1,100 @@
+#include <matrix/db/mem_tables/detail/skip_list.hpp>
+
+#include <new>
+
+namespace whirl::matrix::db {
+
+SkipList::SkipList() {
+  Clear();
+}
+
+SkipList::Node* SkipList::NewNode(std::string_view key, size_t height) {
+  size_t bytes = sizeof(Node) + sizeof(Node*) * (height - 1);
+  Node* node = new (arena_.AllocateAligned(bytes)) Node;
+
+  node->key = ArenaString(key, arena_);
+  node->tombstone = true;
+  node->height = height;
+  for (size_t level = 0; level < height; ++level) {
+    node->next[level] = nullptr;
+  }
+  return node;
+}
+
+SkipList::Node* SkipList::FindGreaterOrEqual(std::string_view key,
+                                             Node** prev) const {
+  Node* curr = head_;
+  size_t level = height_ - 1;
+  while (true) {
+    Node* next = curr->next[level];
+    if (next != nullptr && next->key.View() < key) {
+      curr = next;  // Keep searching in this level
+    } else {
+      if (prev != nullptr) {
+        prev[level] = curr;
+      }
+      if (level == 0) {
+        return next;
+      }
+      --level;
+    }
+  }
+}
+
+SkipList::Node* SkipList::Find(std::string_view key) const {
+  Node* node = FindGreaterOrEqual(key, nullptr);
+  if (node != nullptr && node->key.View() == key) {
+    return node;
+  }
+  return nullptr;
+}
+
+SkipList::Node* SkipList::Insert(std::string_view key) {
+  Node* prev[kMaxHeight];
+  FindGreaterOrEqual(key, prev);
+
+  size_t height = RandomHeight();
+  if (height > height_) {
+    for (size_t level = height_; level < height; ++level) {
+      prev[level] = head_;
+    }
+    height_ = height;
+  }
+
+  Node* node = NewNode(key, height);
+  for (size_t level = 0; level < height; ++level) {
+    node->next[level] = prev[level]->next[level];
+    prev[level]->next[level] = node;
+  }
+
+  ++size_;
+  return node;
+}
+
+void SkipList::Clear() {
+  arena_.Reset();
+
+  head_ = NewNode(/*key=*/"", kMaxHeight);
+  height_ = 1;
+  size_ = 0;
+
+  random_state_ = 0x2545F4914F6CDD1DULL;
+}
+
+size_t SkipList::RandomHeight() {
+  // xorshift64
+  random_state_ ^= random_state_ << 13;
+  random_state_ ^= random_state_ >> 7;
+  random_state_ ^= random_state_ << 17;
+
+  // Branching factor 4
+  uint64_t bits = random_state_;
+  size_t height = 1;
+  while (height < kMaxHeight && (bits & 3) == 0) {
+    ++height;
+    bits >>= 2;
+  }
+  return height;
+}
+
+}  // namespace whirl::matrix::db
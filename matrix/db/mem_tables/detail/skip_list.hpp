@@ -0,0 +1,91 @@
+#pragma once
+
+#include <matrix/db/entries.hpp>
+#include <matrix/db/mem_tables/detail/arena.hpp>
+#include <matrix/db/mem_tables/detail/arena_string.hpp>
+
+#include <cstdint>
+#include <string_view>
+
+namespace whirl::matrix::db {
+
+// Ordered part of skiplist-based memtables
+// Nodes, keys and values are allocated from arena
+// Nodes are never removed individually: deletions are tombstones
+
+class SkipList {
+ public:
+  static const size_t kMaxHeight = 12;
+
+  struct Node {
+    ArenaString key;
+    ArenaString value;
+    bool tombstone;
+    uint8_t height;
+    // Forward links, `height` of them are allocated
+    Node* next[1];
+
+    MaybeValue Value() const {
+      if (tombstone) {
+        return std::nullopt;
+      }
+      return node::db::Value{value.View()};
+    }
+  };
+
+ public:
+  SkipList();
+
+  // Non-copyable
+  SkipList(const SkipList&) = delete;
+  SkipList& operator=(const SkipList&) = delete;
+
+  // nullptr if not found
+  Node* Find(std::string_view key) const;
+
+  // Precondition: `key` is not in list
+  // New node is a tombstone
+  Node* Insert(std::string_view key);
+
+  void Assign(Node* node, std::string_view value) {
+    node->value = ArenaString(value, arena_);
+    node->tombstone = false;
+  }
+
+  void Erase(Node* node) {
+    node->tombstone = true;
+  }
+
+  // Level 0 traversal
+  const Node* First() const {
+    return head_->next[0];
+  }
+
+  // O(1)
+  void Clear();
+
+  size_t Size() const {
+    return size_;
+  }
+
+ private:
+  Node* NewNode(std::string_view key, size_t height);
+
+  // First node with key >= `key`, fills `prev` if not nullptr
+  Node* FindGreaterOrEqual(std::string_view key, Node** prev) const;
+
+  size_t RandomHeight();
+
+ private:
+  Arena arena_;
+
+  Node* head_;
+  size_t height_ = 1;
+  size_t size_ = 0;
+
+  // Private generator: node heights should not
+  // consume global randomness
+  uint64_t random_state_;
+};
+
+}  // namespace whirl::matrix::db
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <matrix/db/mem_table.hpp>
+#include <matrix/db/mem_tables/detail/skip_list.hpp>
+#include <matrix/db/mem_tables/detail/hash_index.hpp>
+
+#include <optional>
+
+namespace whirl::matrix::db {
+
+// Arena skiplist, optionally with hash index for point reads
+
+class SkipListMemTable : public IMemTable {
+ public:
+  explicit SkipListMemTable(bool hash_index) {
+    if (hash_index) {
+      index_.emplace();
+    }
+  }
+
+  void Put(node::db::Key key, node::db::Value value) override {
+    bytes_ += key.size() + value.size();
+    list_.Assign(FindOrInsert(key), value);
+  }
+
+  void Delete(node::db::Key key) override {
+    bytes_ += key.size();
+    list_.Erase(FindOrInsert(key));
+  }
+
+  bool TryGet(const node::db::Key& key, MaybeValue& value) const override {
+    SkipList::Node* node = Find(key);
+    if (node == nullptr) {
+      return false;
+    }
+    value = node->Value();
+    return true;
+  }
+
+  // O(1)
+  void Clear() override {
+    if (index_) {
+      index_->Clear();
+    }
+    list_.Clear();
+    bytes_ = 0;
+  }
+
+  bool IsEmpty() const override {
+    return list_.Size() == 0;
+  }
+
+  size_t ApproximateBytes() const override {
+    return bytes_;
+  }
+
+  void ForEach(const EntryVisitor& visitor) const override {
+    for (const auto* node = list_.First(); node != nullptr;
+         node = node->next[0]) {
+      visitor(node::db::Key{node->key.View()}, node->Value());
+    }
+  }
+
+ private:
+  SkipList::Node* Find(std::string_view key) const {
+    if (index_) {
+      return index_->Find(key);
+    }
+    return list_.Find(key);
+  }
+
+  SkipList::Node* FindOrInsert(std::string_view key) {
+    if (SkipList::Node* node = Find(key)) {
+      return node;
+    }
+    SkipList::Node* node = list_.Insert(key);
+    if (index_) {
+      index_->Insert(node);
+    }
+    return node;
+  }
+
+ private:
+  SkipList list_;
+  std::optional<HashIndex> index_;
+  size_t bytes_ = 0;
+};
+
+}  // namespace whirl::matrix::db
@@ -0,0 +1,11 @@
+#include <matrix/db/mem_tables/hash.hpp>
+
+#include <matrix/db/mem_tables/detail/skip_list_mem_table.hpp>
+
+namespace whirl::matrix::db {
+
+IMemTablePtr MakeHashMemTable() {
+  return std::make_unique<SkipListMemTable>(/*hash_index=*/true);
+}
+
+}  // namespace whirl::matrix::db
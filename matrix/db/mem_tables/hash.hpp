@@ -0,0 +1,12 @@
+#pragma once
+
+#include <matrix/db/mem_table.hpp>
+
+namespace whirl::matrix::db {
+
+// Arena skiplist for ordered access + open-addressing hash index over
+// skiplist nodes for O(1) point reads
+
+IMemTablePtr MakeHashMemTable();
+
+}  // namespace whirl::matrix::db
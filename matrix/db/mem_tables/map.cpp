@@ -0,0 +1,54 @@
+#include <matrix/db/mem_tables/map.hpp>
+
+namespace whirl::matrix::db {
+
+class MapMemTable : public IMemTable {
+ public:
+  void Put(node::db::Key key, node::db::Value value) override {
+    bytes_ += key.size() + value.size();
+    entries_.insert_or_assign(std::move(key), std::move(value));
+  }
+
+  void Delete(node::db::Key key) override {
+    bytes_ += key.size();
+    entries_.insert_or_assign(std::move(key), std::nullopt);
+  }
+
+  bool TryGet(const node::db::Key& key, MaybeValue& value) const override {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return false;
+    }
+    value = it->second;
+    return true;
+  }
+
+  void Clear() override {
+    entries_.clear();
+    bytes_ = 0;
+  }
+
+  bool IsEmpty() const override {
+    return entries_.empty();
+  }
+
+  size_t ApproximateBytes() const override {
+    return bytes_;
+  }
+
+  void ForEach(const EntryVisitor& visitor) const override {
+    for (const auto& [key, value] : entries_) {
+      visitor(key, value);
+    }
+  }
+
+ private:
+  Entries entries_;
+  size_t bytes_ = 0;
+};
+
+IMemTablePtr MakeMapMemTable() {
+  return std::make_unique<MapMemTable>();
+}
+
+}  // namespace whirl::matrix::db
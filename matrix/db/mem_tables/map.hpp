@@ -0,0 +1,11 @@
+#pragma once
+
+#include <matrix/db/mem_table.hpp>
+
+namespace whirl::matrix::db {
+
+// std::map: O(log n) string comparisons for both point and ordered access
+
+IMemTablePtr MakeMapMemTable();
+
+}  // namespace whirl::matrix::db
@@ -0,0 +1,11 @@
+#include <matrix/db/mem_tables/skip_list.hpp>
+
+#include <matrix/db/mem_tables/detail/skip_list_mem_table.hpp>
+
+namespace whirl::matrix::db {
+
+IMemTablePtr MakeSkipListMemTable() {
+  return std::make_unique<SkipListMemTable>(/*hash_index=*/false);
+}
+
+}  // namespace whirl::matrix::db
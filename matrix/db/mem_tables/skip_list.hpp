@@ -0,0 +1,12 @@
+#pragma once
+
+#include <matrix/db/mem_table.hpp>
+
+namespace whirl::matrix::db {
+
+// Skiplist with nodes, keys and values allocated from a single arena:
+// allocation-free inserts (amortized), O(1) Clear
+
+IMemTablePtr MakeSkipListMemTable();
+
+}  // namespace whirl::matrix::db
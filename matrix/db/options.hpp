@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdlib>
+
+namespace whirl::matrix::db {
+
+enum class MemTableKind {
+  Map,       // std::map
+  Hash,      // Skiplist + hash index
+  SkipList,  // Arena skiplist
+};
+
+struct Options {
+  MemTableKind mem_table = MemTableKind::Map;
+
+  // Flush memtable to L0 table when it grows beyond this size
+  size_t memtable_bytes = 4 * 1024;
+
+  // Target size of uncompressed data block
+  size_t block_bytes = 512;
+
+  // Target size of table produced by compaction
+  size_t table_bytes = 8 * 1024;
+
+  // Bloom filter
+  size_t bloom_bits_per_key = 10;
+
+  // Capacity of LRU data block cache, 0 disables caching
+  size_t block_cache_bytes = 16 * 1024;
+
+  // Checkpoint memtable every `checkpoint_interval` WAL records,
+  // 0 disables checkpoints
+  size_t checkpoint_interval = 64;
+
+  // Compaction
+
+  // Number of L0 tables that triggers L0 -> L1 compaction
+  size_t l0_compaction_trigger = 4;
+
+  // Size limit for L1, multiplied by `level_size_multiplier`
+  // for each next level
+  size_t l1_max_bytes = 32 * 1024;
+  size_t level_size_multiplier = 10;
+};
+
+}  // namespace whirl::matrix::db
@@ -0,0 +1,85 @@
+#include <matrix/db/reader.hpp>
+
+#include <matrix/server/runtime/filesystem.hpp>
+
+#include <matrix/world/global/log.hpp>
+
+#include <muesli/serialize.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <timber/log.hpp>
+
+namespace whirl::matrix::db {
+
+TableReader::TableReader(matrix::FS* fs, size_t cache_bytes,
+                         BlockCacheStats* stats)
+    : fs_(fs),
+      cache_(cache_bytes, stats),
+      logger_("Database", GetLogBackend()) {
+}
+
+TableRef TableReader::Open(persist::fs::Path path, TableInfo info) {
+  auto meta_bytes = Read(path, info.meta_offset, info.meta_size);
+  auto meta = muesli::Deserialize<TableMeta>(meta_bytes);
+  return std::make_shared<Table>(fs_, std::move(path), std::move(info),
+                                 std::move(meta));
+}
+
+BlockRef TableReader::ReadBlock(const Table& table, size_t index) {
+  if (auto block = cache_.Lookup(table.Number(), index)) {
+    return block;
+  }
+
+  LOG_INFO("Block cache miss, read block {} of table #{} from disk", index,
+           table.Number());
+
+  const auto& handle = table.GetBlock(index);
+  auto bytes = Read(table.FilePath(), handle.offset, handle.size);
+  auto block =
+      std::make_shared<const Block>(muesli::Deserialize<Block>(bytes));
+
+  cache_.Insert(table.Number(), index, block, handle.size);
+
+  return block;
+}
+
+std::vector<TableEntry> TableReader::ReadAll(const Table& table) {
+  const auto& info = table.Info();
+
+  // Data blocks are stored contiguously
+  auto bytes = Read(table.FilePath(), 0, info.meta_offset);
+
+  std::vector<TableEntry> entries;
+  entries.reserve(info.entries);
+
+  for (size_t i = 0; i < table.BlockCount(); ++i) {
+    const auto& handle = table.GetBlock(i);
+    auto block =
+        muesli::Deserialize<Block>(bytes.substr(handle.offset, handle.size));
+    for (auto& entry : block.entries) {
+      entries.push_back(std::move(entry));
+    }
+  }
+
+  return entries;
+}
+
+std::string TableReader::Read(const persist::fs::Path& path, uint64_t offset,
+                              uint64_t size) {
+  auto fd = fs_->Open(path, persist::fs::FileMode::Read)
+                .ExpectValueOr("Failed to open table file");
+
+  std::string buffer(size, '\0');
+  size_t bytes_read =
+      fs_->PRead(fd, offset, {buffer.data(), buffer.size()})
+          .ExpectValueOr("Failed to read table file");
+
+  fs_->Close(fd).ExpectOk();
+
+  WHEELS_VERIFY(bytes_read == size, "Table file is truncated");
+
+  return buffer;
+}
+
+}  // namespace whirl::matrix::db
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <matrix/db/table.hpp>
+#include <matrix/db/cache.hpp>
+
+#include <timber/logger.hpp>
+
+#include <string>
+#include <vector>
+
+namespace whirl::matrix::db {
+
+// Reads tables from (simulated) disk
+
+class TableReader {
+ public:
+  TableReader(matrix::FS* fs, size_t cache_bytes, BlockCacheStats* stats);
+
+  // Reads table meta (index + filter)
+  TableRef Open(persist::fs::Path path, TableInfo info);
+
+  // Point access via block cache, context: Iterator / TryGet
+  BlockRef ReadBlock(const Table& table, size_t index);
+
+  // Full scan bypassing block cache, context: Compaction
+  std::vector<TableEntry> ReadAll(const Table& table);
+
+ private:
+  std::string Read(const persist::fs::Path& path, uint64_t offset,
+                   uint64_t size);
+
+ private:
+  matrix::FS* fs_;
+  BlockCache cache_;
+
+  timber::Logger logger_;
+};
+
+}  // namespace whirl::matrix::db
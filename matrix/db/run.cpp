@@ -0,0 +1,145 @@
+#include <matrix/db/run.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <algorithm>
+
+namespace whirl::matrix::db {
+
+using node::db::Key;
+
+static bool EntryLess(const TableEntry& entry, const Key& key) {
+  return entry.key < key;
+}
+
+static bool KeyLess(const Key& key, const TableEntry& entry) {
+  return key < entry.key;
+}
+
+bool SortedRun::Get(const Key& key, MaybeValue& value) const {
+  auto it = std::partition_point(tables_.begin(), tables_.end(),
+                                 [&key](const TableRef& table) {
+                                   return table->Largest() < key;
+                                 });
+
+  if (it == tables_.end() || !(*it)->MayContain(key)) {
+    return false;
+  }
+
+  const Table& table = **it;
+
+  auto block = ReadBlock(table, table.FindBlock(key));
+  const auto& entries = block->entries;
+
+  auto pos =
+      std::lower_bound(entries.begin(), entries.end(), key, EntryLess);
+  if (pos == entries.end() || pos->key != key) {
+    return false;  // Bloom filter false positive
+  }
+
+  value = pos->Get();
+  return true;
+}
+
+std::optional<TableEntry> SortedRun::Before(const Key& key) const {
+  auto it = std::partition_point(tables_.begin(), tables_.end(),
+                                 [&key](const TableRef& table) {
+                                   return table->Smallest() < key;
+                                 });
+  if (it == tables_.begin()) {
+    return std::nullopt;
+  }
+
+  const Table& table = **std::prev(it);
+
+  size_t index = table.FindBlock(key);
+
+  if (index == table.BlockCount()) {
+    // All keys in table are less than `key`
+    auto block = ReadBlock(table, index - 1);
+    return block->entries.back();
+  }
+
+  auto block = ReadBlock(table, index);
+  const auto& entries = block->entries;
+
+  auto pos =
+      std::lower_bound(entries.begin(), entries.end(), key, EntryLess);
+  if (pos != entries.begin()) {
+    return *std::prev(pos);
+  }
+
+  // First key in block >= `key`, table.Smallest() < `key` => index > 0
+  WHEELS_VERIFY(index > 0, "Broken table index");
+  auto prev_block = ReadBlock(table, index - 1);
+  return prev_block->entries.back();
+}
+
+std::optional<TableEntry> SortedRun::Last() const {
+  if (tables_.empty()) {
+    return std::nullopt;
+  }
+
+  const Table& table = *tables_.back();
+  auto block = ReadBlock(table, table.BlockCount() - 1);
+  return block->entries.back();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void RunCursor::Seek(const Key& key, bool inclusive) {
+  const auto& tables = run_->tables_;
+
+  auto it = std::partition_point(
+      tables.begin(), tables.end(), [&](const TableRef& table) {
+        return inclusive ? table->Largest() < key : table->Largest() <= key;
+      });
+
+  table_ = it - tables.begin();
+  if (table_ == tables.size()) {
+    block_.reset();
+    return;
+  }
+
+  const Table& table = **it;
+  block_index_ = inclusive ? table.FindBlock(key) : table.FindBlockAfter(key);
+  ReadBlock();
+
+  const auto& entries = block_->entries;
+  auto pos = inclusive
+                 ? std::lower_bound(entries.begin(), entries.end(), key,
+                                    EntryLess)
+                 : std::upper_bound(entries.begin(), entries.end(), key,
+                                    KeyLess);
+  pos_ = pos - entries.begin();
+  SkipExhausted();
+}
+
+void RunCursor::Next() {
+  WHEELS_VERIFY(Valid(), "Invalid run cursor");
+  ++pos_;
+  SkipExhausted();
+}
+
+void RunCursor::ReadBlock() {
+  const Table& table = *run_->tables_[table_];
+  block_ = run_->ReadBlock(table, block_index_);
+  pos_ = 0;
+}
+
+void RunCursor::SkipExhausted() {
+  const auto& tables = run_->tables_;
+
+  while (pos_ == block_->entries.size()) {
+    if (++block_index_ == tables[table_]->BlockCount()) {
+      block_index_ = 0;
+      if (++table_ == tables.size()) {
+        block_.reset();
+        return;
+      }
+    }
+    ReadBlock();
+  }
+}
+
+}  // namespace whirl::matrix::db
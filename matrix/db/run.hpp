@@ -0,0 +1,79 @@
+#pragma once
+
+#include <matrix/db/reader.hpp>
+
+#include <optional>
+#include <vector>
+
+namespace whirl::matrix::db {
+
+// Sequence of tables with disjoint key ranges, sorted by key
+// L0 table forms a run by itself
+
+class SortedRun {
+ public:
+  SortedRun(std::vector<TableRef> tables, TableReader* reader)
+      : tables_(std::move(tables)), reader_(reader) {
+  }
+
+  // Point lookup
+  // Returns false if key not found, tombstone otherwise
+  bool Get(const node::db::Key& key, MaybeValue& value) const;
+
+  // Ordered access for iterators, see also RunCursor
+
+  // Last entry with key < `key`
+  std::optional<TableEntry> Before(const node::db::Key& key) const;
+  // Last entry in run
+  std::optional<TableEntry> Last() const;
+
+ private:
+  friend class RunCursor;
+
+  BlockRef ReadBlock(const Table& table, size_t index) const {
+    return reader_->ReadBlock(table, index);
+  }
+
+ private:
+  std::vector<TableRef> tables_;
+  TableReader* reader_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Forward cursor over sorted run
+// Holds current block, so stepping reads each block once
+
+class RunCursor {
+ public:
+  explicit RunCursor(const SortedRun* run) : run_(run) {
+  }
+
+  // First entry with key >= (inclusive) or > `key`
+  void Seek(const node::db::Key& key, bool inclusive);
+
+  void Next();
+
+  bool Valid() const {
+    return block_ != nullptr;
+  }
+
+  const TableEntry& Entry() const {
+    return block_->entries[pos_];
+  }
+
+ private:
+  void ReadBlock();
+  // Moves past exhausted blocks and tables
+  void SkipExhausted();
+
+ private:
+  const SortedRun* run_;
+
+  size_t table_ = 0;
+  size_t block_index_ = 0;
+  BlockRef block_;
+  size_t pos_ = 0;
+};
+
+}  // namespace whirl::matrix::db
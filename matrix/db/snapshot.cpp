@@ -1,17 +1,17 @@
 #include <matrix/db/snapshot.hpp>
 
+#include <matrix/db/database.hpp>
 #include <matrix/db/iterator.hpp>
 
 namespace whirl::matrix::db {
 
 std::optional<node::db::Value> Snapshot::TryGet(
     const node::db::Key& key) const {
-  auto it = entries_.find(key);
-  if (it != entries_.end()) {
+  auto it = mem_table_.find(key);
+  if (it != mem_table_.end()) {
     return it->second;
-  } else {
-    return std::nullopt;
   }
+  return db_->LookupTables(*tables_, key);
 }
 
 node::db::IIteratorPtr Snapshot::MakeIterator() {
@@ -3,18 +3,23 @@
 #include <whirl/node/db/snapshot.hpp>
 
 #include <matrix/db/entries.hpp>
+#include <matrix/db/version.hpp>
 
 namespace whirl::matrix::db {
 
 class Database;
 
+// MemTable copy + pinned tables
+
 class Snapshot : public node::db::ISnapshot,
                  public std::enable_shared_from_this<Snapshot> {
  public:
-  Snapshot(Database* db, Entries entries, uint64_t version)
+  Snapshot(Database* db, Entries mem_table, VersionRef tables,
+           uint64_t version)
       : db_(db),
-        entries_(std::move(entries))
-      , version_(version) {
+        mem_table_(std::move(mem_table)),
+        tables_(std::move(tables)),
+        version_(version) {
   }
 
   // ISnapshot
@@ -26,8 +31,12 @@ class Snapshot : public node::db::ISnapshot,
 
   // Access
 
-  const Entries& GetEntries() const {
-    return entries_;
+  const Entries& GetMemTable() const {
+    return mem_table_;
+  }
+
+  const VersionRef& GetTables() const {
+    return tables_;
   }
 
   uint64_t Version() const {
@@ -40,7 +49,8 @@ class Snapshot : public node::db::ISnapshot,
 
  private:
   Database* db_;
-  const Entries entries_;
+  const Entries mem_table_;
+  const VersionRef tables_;
   uint64_t version_;
 };
 
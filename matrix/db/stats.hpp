@@ -0,0 +1,45 @@
+#pragma once
+
+#include <whirl/node/time/jiffies.hpp>
+
+#include <cstdlib>
+
+namespace whirl::matrix::db {
+
+// Cumulative, survive server crashes
+
+struct BlockCacheStats {
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t evictions = 0;
+
+  double HitRatio() const {
+    size_t lookups = hits + misses;
+    if (lookups == 0) {
+      return 0;
+    }
+    return (double)hits / lookups;
+  }
+};
+
+// Memtable recovery in Database::Open
+
+struct ReplayStats {
+  size_t replays = 0;
+
+  // Last replay
+  Jiffies last_time = 0;
+  size_t last_checkpoint_entries = 0;
+  size_t last_wal_records = 0;
+
+  // Total over all replays
+  Jiffies total_time = 0;
+  size_t total_wal_records = 0;
+};
+
+struct Stats {
+  BlockCacheStats block_cache;
+  ReplayStats replay;
+};
+
+}  // namespace whirl::matrix::db
@@ -0,0 +1,114 @@
+#include <matrix/db/table.hpp>
+
+#include <matrix/db/bloom.hpp>
+
+#include <matrix/server/runtime/filesystem.hpp>
+
+#include <muesli/serialize.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <algorithm>
+
+namespace whirl::matrix::db {
+
+//////////////////////////////////////////////////////////////////////
+
+TableBuilder::TableBuilder(const Options& options) : options_(options) {
+}
+
+void TableBuilder::Add(const node::db::Key& key, const MaybeValue& value) {
+  WHEELS_VERIFY(keys_.empty() || keys_.back() < key, "Unordered keys");
+
+  if (value.has_value()) {
+    block_.entries.push_back({key, false, *value});
+    block_bytes_ += key.size() + value->size();
+  } else {
+    block_.entries.push_back({key, true, {}});
+    block_bytes_ += key.size();
+  }
+
+  keys_.push_back(key);
+  ++entries_;
+
+  if (block_bytes_ >= options_.block_bytes) {
+    FlushBlock();
+  }
+}
+
+void TableBuilder::FlushBlock() {
+  if (block_.entries.empty()) {
+    return;
+  }
+
+  auto bytes = muesli::Serialize(block_);
+
+  meta_.index.push_back(
+      {block_.entries.back().key, image_.size(), bytes.size()});
+  image_.append(bytes);
+
+  block_.entries.clear();
+  block_bytes_ = 0;
+}
+
+std::string TableBuilder::Finish(TableInfo& info, TableMeta& meta) {
+  WHEELS_VERIFY(!IsEmpty(), "Empty table");
+
+  FlushBlock();
+
+  meta_.filter = BloomFilter::Build(keys_, options_.bloom_bits_per_key);
+
+  info.smallest = keys_.front();
+  info.largest = keys_.back();
+  info.entries = entries_;
+
+  auto meta_bytes = muesli::Serialize(meta_);
+  info.meta_offset = image_.size();
+  info.meta_size = meta_bytes.size();
+  image_.append(meta_bytes);
+  info.file_size = image_.size();
+
+  meta = std::move(meta_);
+
+  return std::move(image_);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+Table::Table(matrix::FS* fs, persist::fs::Path path, TableInfo info,
+             TableMeta meta)
+    : fs_(fs),
+      path_(std::move(path)),
+      info_(std::move(info)),
+      meta_(std::move(meta)) {
+}
+
+Table::~Table() {
+  if (obsolete_) {
+    fs_->Unlink(path_).ExpectOk();
+  }
+}
+
+bool Table::MayContain(const node::db::Key& key) const {
+  return InRange(key) && BloomFilter::MayContain(meta_.filter, key);
+}
+
+size_t Table::FindBlock(const node::db::Key& key) const {
+  auto it = std::partition_point(
+      meta_.index.begin(), meta_.index.end(),
+      [&key](const BlockHandle& block) {
+        return block.last_key < key;
+      });
+  return it - meta_.index.begin();
+}
+
+size_t Table::FindBlockAfter(const node::db::Key& key) const {
+  auto it = std::partition_point(
+      meta_.index.begin(), meta_.index.end(),
+      [&key](const BlockHandle& block) {
+        return block.last_key <= key;
+      });
+  return it - meta_.index.begin();
+}
+
+}  // namespace whirl::matrix::db
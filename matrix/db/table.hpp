@@ -0,0 +1,218 @@
+#pragma once
+
+#include <whirl/node/db/kv.hpp>
+
+#include <persist/fs/path.hpp>
+
+#include <matrix/db/entries.hpp>
+#include <matrix/db/options.hpp>
+
+#include <muesli/serializable.hpp>
+
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace whirl::matrix {
+
+class FS;
+
+}  // namespace whirl::matrix
+
+namespace whirl::matrix::db {
+
+// Sorted immutable table (SSTable)
+
+// File layout:
+// [data block 1] ... [data block N] [meta: index + bloom filter]
+// Meta location is stored in manifest (TableInfo)
+
+//////////////////////////////////////////////////////////////////////
+
+struct TableEntry {
+  node::db::Key key;
+  bool tombstone;
+  node::db::Value value;
+
+  MaybeValue Get() const {
+    if (tombstone) {
+      return std::nullopt;
+    }
+    return value;
+  }
+
+  MUESLI_SERIALIZABLE(key, tombstone, value)
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Data block, sorted by key
+struct Block {
+  std::vector<TableEntry> entries;
+
+  MUESLI_SERIALIZABLE(entries)
+};
+
+using BlockRef = std::shared_ptr<const Block>;
+
+//////////////////////////////////////////////////////////////////////
+
+struct BlockHandle {
+  node::db::Key last_key;
+  uint64_t offset;
+  uint64_t size;
+
+  MUESLI_SERIALIZABLE(last_key, offset, size)
+};
+
+// Pinned in memory while table is alive
+struct TableMeta {
+  // Block index
+  std::vector<BlockHandle> index;
+  // Bloom filter over all keys in table
+  std::string filter;
+
+  MUESLI_SERIALIZABLE(index, filter)
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Table descriptor, persisted in manifest
+struct TableInfo {
+  uint64_t number;
+  uint64_t level;
+
+  node::db::Key smallest;
+  node::db::Key largest;
+
+  uint64_t entries;
+  uint64_t file_size;
+
+  uint64_t meta_offset;
+  uint64_t meta_size;
+
+  MUESLI_SERIALIZABLE(number, level, smallest, largest, entries, file_size,
+                      meta_offset, meta_size)
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Builds table file image in memory
+
+class TableBuilder {
+ public:
+  explicit TableBuilder(const Options& options);
+
+  // Keys in strictly increasing order
+  void Add(const node::db::Key& key, const MaybeValue& value);
+
+  bool IsEmpty() const {
+    return entries_ == 0;
+  }
+
+  size_t EstimatedSize() const {
+    return image_.size() + block_bytes_;
+  }
+
+  // Returns file image
+  // Fills `info` (except `number` and `level`) and `meta`
+  std::string Finish(TableInfo& info, TableMeta& meta);
+
+ private:
+  void FlushBlock();
+
+ private:
+  const Options& options_;
+
+  std::string image_;
+
+  Block block_;
+  size_t block_bytes_ = 0;
+
+  TableMeta meta_;
+  std::vector<node::db::Key> keys_;
+  size_t entries_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Immutable table on disk
+// Data blocks are read on demand, see TableReader
+
+class Table {
+ public:
+  Table(matrix::FS* fs, persist::fs::Path path, TableInfo info,
+        TableMeta meta);
+
+  // Unlinks obsolete table file
+  ~Table();
+
+  // Non-copyable
+  Table(const Table&) = delete;
+  Table& operator=(const Table&) = delete;
+
+  const TableInfo& Info() const {
+    return info_;
+  }
+
+  uint64_t Number() const {
+    return info_.number;
+  }
+
+  const node::db::Key& Smallest() const {
+    return info_.smallest;
+  }
+
+  const node::db::Key& Largest() const {
+    return info_.largest;
+  }
+
+  const persist::fs::Path& FilePath() const {
+    return path_;
+  }
+
+  bool InRange(const node::db::Key& key) const {
+    return info_.smallest <= key && key <= info_.largest;
+  }
+
+  // Key range + bloom filter
+  bool MayContain(const node::db::Key& key) const;
+
+  // Index
+
+  size_t BlockCount() const {
+    return meta_.index.size();
+  }
+
+  const BlockHandle& GetBlock(size_t index) const {
+    return meta_.index[index];
+  }
+
+  // First block with last key >= `key` or BlockCount()
+  size_t FindBlock(const node::db::Key& key) const;
+  // First block with last key > `key` or BlockCount()
+  size_t FindBlockAfter(const node::db::Key& key) const;
+
+  // After compaction
+  // File will be removed when last reference to table is dropped
+  void MarkObsolete() {
+    obsolete_ = true;
+  }
+
+ private:
+  matrix::FS* fs_;
+  persist::fs::Path path_;
+
+  TableInfo info_;
+  TableMeta meta_;
+
+  bool obsolete_{false};
+};
+
+using TableRef = std::shared_ptr<Table>;
+
+}  // namespace whirl::matrix::db
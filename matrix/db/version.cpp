@@ -0,0 +1,37 @@
+#include <matrix/db/version.hpp>
+
+namespace whirl::matrix::db {
+
+size_t Version::LevelBytes(size_t level) const {
+  size_t bytes = 0;
+  for (const auto& table : levels[level]) {
+    bytes += table->Info().file_size;
+  }
+  return bytes;
+}
+
+std::vector<TableRef> Version::Overlapping(
+    size_t level, const node::db::Key& smallest,
+    const node::db::Key& largest) const {
+  std::vector<TableRef> overlapping;
+  for (const auto& table : levels[level]) {
+    if (table->Largest() < smallest || largest < table->Smallest()) {
+      continue;
+    }
+    overlapping.push_back(table);
+  }
+  return overlapping;
+}
+
+bool Version::IsBaseLevelFor(size_t level, const node::db::Key& key) const {
+  for (size_t lower = level + 1; lower < kNumLevels; ++lower) {
+    for (const auto& table : levels[lower]) {
+      if (table->InRange(key)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace whirl::matrix::db
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <matrix/db/table.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace whirl::matrix::db {
+
+static const size_t kNumLevels = 4;
+
+// Immutable set of live tables
+// Pinned by snapshots and iterators
+
+struct Version {
+  // L0: newest first, key ranges may overlap
+  // L1+: sorted by key, key ranges are disjoint
+  std::array<std::vector<TableRef>, kNumLevels> levels;
+
+  size_t LevelBytes(size_t level) const;
+
+  // Tables in `level` overlapping with [smallest, largest]
+  std::vector<TableRef> Overlapping(size_t level,
+                                    const node::db::Key& smallest,
+                                    const node::db::Key& largest) const;
+
+  // No tables below `level` contain `key`
+  bool IsBaseLevelFor(size_t level, const node::db::Key& key) const;
+};
+
+using VersionRef = std::shared_ptr<const Version>;
+
+//////////////////////////////////////////////////////////////////////
+
+// Persistent database state (except memtable)
+
+struct ManifestRecord {
+  uint64_t next_file_number;
+  // WAL with mutations not yet flushed to tables
+  // Checkpoints with smaller numbers are stale
+  uint64_t log_number;
+  // Database version at the last memtable flush
+  uint64_t version;
+
+  std::vector<TableInfo> tables;
+
+  MUESLI_SERIALIZABLE(next_file_number, log_number, version, tables)
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Memtable image, replaces the WAL prefix
+
+struct CheckpointRecord {
+  // Database version at checkpoint
+  uint64_t version;
+  // Sorted by key, with tombstones
+  std::vector<TableEntry> entries;
+
+  MUESLI_SERIALIZABLE(version, entries)
+};
+
+}  // namespace whirl::matrix::db
@@ -5,7 +5,7 @@
 namespace whirl::matrix::facade {
 
 PoolBuilder::~PoolBuilder() {
-  world_->AddPool(pool_name_, program_, size_, name_template_);
+  world_->AddPool(pool_name_, program_, size_, name_template_, options_);
 }
 
 World::World(size_t seed) : impl_(std::make_unique<matrix::World>(seed)) {
@@ -23,8 +23,9 @@ void World::AddServer(std::string hostname, node::program::Main program) {
 }
 
 void World::AddPool(std::string pool_name, node::program::Main program,
-                    size_t size, std::string server_name_template) {
-  impl_->AddPool(pool_name, program, size, server_name_template);
+                    size_t size, std::string server_name_template,
+                    ServerOptions options) {
+  impl_->AddPool(pool_name, program, size, server_name_template, options);
 }
 
 void World::AddClient(node::program::Main program) {
@@ -41,6 +42,30 @@ void World::SetTimeModel(ITimeModelPtr time_model) {
   impl_->SetTimeModel(std::move(time_model));
 }
 
+void World::DisableNextStepCache() {
+  impl_->SetNextStepCache(false);
+}
+
+void World::SetZoneLatency(const std::string& lhs, const std::string& rhs,
+                           Jiffies rtt, Jiffies jitter) {
+  auto& topology = impl_->GetNetwork().GetTopology();
+  topology.SetZoneLatency(topology.GetZone(lhs), topology.GetZone(rhs), rtt,
+                          jitter);
+}
+
+void World::SetCrossRackLatency(Jiffies rtt, Jiffies jitter) {
+  impl_->GetNetwork().GetTopology().SetCrossRackLatency(rtt, jitter);
+}
+
+void World::SetDefaultLinkParams(net::LinkParams params) {
+  impl_->GetNetwork().SetDefaultLinkParams(params);
+}
+
+void World::SetLinkParams(const std::string& start, const std::string& end,
+                          net::LinkParams params) {
+  impl_->GetNetwork().SetLinkParams(start, end, params);
+}
+
 void World::AddAdversary(node::program::Main program) {
   impl_->AddAdversary(program);
 }
@@ -53,6 +78,35 @@ void World::WriteTraceTo(std::string fpath) {
   impl_->WriteTraceTo(fpath);
 }
 
+void World::SetRandomPrefix(RandomDecisions prefix) {
+  impl_->SetRandomPrefix(std::move(prefix));
+}
+
+void World::RecordRandomTo(RandomDecisions* sink, size_t limit) {
+  impl_->RecordRandomTo(sink, limit);
+}
+
+void World::CollectCoverageTo(Coverage* coverage) {
+  impl_->CollectCoverageTo(coverage);
+}
+
+void World::RecordDecisionsTo(std::string fpath) {
+  impl_->RecordDecisionsTo(fpath);
+}
+
+void World::ReplayDecisionsFrom(std::string fpath) {
+  impl_->ReplayDecisionsFrom(fpath);
+}
+
+void World::LogFromStep(size_t step) {
+  impl_->LogFromStep(step);
+}
+
+void World::RecordCheckpointsTo(Checkpoints* sink,
+                                CheckpointOptions options) {
+  impl_->RecordCheckpointsTo(sink, options);
+}
+
 void World::Start() {
   impl_->Start();
 }
@@ -65,12 +119,24 @@ void World::MakeSteps(size_t count) {
   impl_->MakeSteps(count);
 }
 
+void World::RunUntil(std::function<bool()> done) {
+  impl_->RunUntil(done);
+}
+
 void World::RestartServer(const std::string& hostname) {
   impl_->RestartServer(hostname);
 }
 
 size_t World::Stop() {
-  return impl_->Stop();
+  size_t digest = impl_->Stop();
+  if (stop_hook_) {
+    stop_hook_(*this);
+  }
+  return digest;
+}
+
+void World::OnStop(StopHook hook) {
+  stop_hook_ = std::move(hook);
 }
 
 size_t World::Digest() const {
@@ -89,10 +155,35 @@ std::vector<std::string> World::GetStdout(const std::string& hostname) const {
   return impl_->GetStdout(hostname);
 }
 
+db::BlockCacheStats World::GetDbCacheStats(const std::string& hostname) const {
+  return impl_->GetDbStats(hostname).block_cache;
+}
+
+db::ReplayStats World::GetDbReplayStats(const std::string& hostname) const {
+  return impl_->GetDbStats(hostname).replay;
+}
+
+process::CpuStats World::GetCpuStats(const std::string& hostname) const {
+  return impl_->GetCpuStats(hostname);
+}
+
+net::LinkStats World::GetNetworkStats() const {
+  return impl_->GetNetwork().GetStats();
+}
+
+net::TransportStats World::GetTransportStats(
+    const std::string& hostname) const {
+  return impl_->GetTransportStats(hostname);
+}
+
 size_t World::StepCount() const {
   return impl_->CurrentStep();
 }
 
+size_t World::SkippedSteps() const {
+  return impl_->SkippedSteps();
+}
+
 Jiffies World::TimeElapsed() const {
   return impl_->TimeElapsed();
 }
@@ -3,11 +3,20 @@
 #include <matrix/time_model/time_model.hpp>
 #include <matrix/log/event.hpp>
 #include <matrix/semantics/history.hpp>
+#include <matrix/config/server.hpp>
+#include <matrix/db/stats.hpp>
+#include <matrix/network/link_params.hpp>
+#include <matrix/network/stats.hpp>
+#include <matrix/process/cpu.hpp>
+#include <matrix/world/coverage.hpp>
+#include <matrix/world/random_source.hpp>
+#include <matrix/world/checkpoint.hpp>
 #include <whirl/node/program/main.hpp>
 
 #include <memory>
 #include <ostream>
 #include <any>
+#include <functional>
 
 //////////////////////////////////////////////////////////////////////
 
@@ -48,6 +57,52 @@ class PoolBuilder {
     return *this;
   }
 
+  // Simulated CPU cores on each server, 0 - unlimited
+  PoolBuilder& CpuCores(size_t count) {
+    options_.cpu_cores = count;
+    return *this;
+  }
+
+  // Topology
+
+  PoolBuilder& Zone(std::string name) {
+    options_.zone = name;
+    return *this;
+  }
+
+  // Spread pool servers over `count` racks
+  PoolBuilder& Racks(size_t count) {
+    options_.racks = count;
+    return *this;
+  }
+
+  // Database block cache capacity (bytes) on each server
+  PoolBuilder& DbBlockCache(size_t bytes) {
+    options_.db_block_cache = bytes;
+    return *this;
+  }
+
+  PoolBuilder& DbMemTable(db::MemTableKind kind) {
+    options_.db_mem_table = kind;
+    return *this;
+  }
+
+  // Transport flow control
+
+  // Max unacknowledged bytes per connection
+  PoolBuilder& NetSendWindow(size_t bytes) {
+    options_.net_send_window = bytes;
+    return *this;
+  }
+
+  // Received but not yet handled bytes per endpoint
+  // Free space is advertised to senders as receive window,
+  // messages over capacity are held until handled
+  PoolBuilder& NetRecvBuffer(size_t bytes) {
+    options_.net_recv_buffer = bytes;
+    return *this;
+  }
+
   // Add pool to the world
   ~PoolBuilder();
 
@@ -63,6 +118,7 @@ class PoolBuilder {
   node::program::Main program_;
   size_t size_ = 1;
   std::string name_template_;
+  ServerOptions options_;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -89,6 +145,25 @@ class World {
 
   void SetTimeModel(ITimeModelPtr time_model);
 
+  // Poll every actor before each step instead of caching
+  // next step times and skipping through quiescent periods,
+  // trajectory and digest must not change
+  void DisableNextStepCache();
+
+  // Topology
+  // Latencies are added to flight times chosen by time model
+
+  void SetZoneLatency(const std::string& lhs, const std::string& rhs,
+                      Jiffies rtt, Jiffies jitter = 0);
+  void SetCrossRackLatency(Jiffies rtt, Jiffies jitter = 0);
+
+  // Links: bandwidth and transmission queue
+
+  void SetDefaultLinkParams(net::LinkParams params);
+  // One-way link
+  void SetLinkParams(const std::string& start, const std::string& end,
+                     net::LinkParams params);
+
   void AddAdversary(node::program::Main program);
 
   // Globals
@@ -118,20 +193,49 @@ class World {
 
   void WriteTraceTo(std::string fpath);
 
+  // Exploration (see TestRunner::Explore)
+
+  // Override first random decisions of the simulation
+  void SetRandomPrefix(RandomDecisions prefix);
+  // Record first `limit` random decisions to `sink`
+  void RecordRandomTo(RandomDecisions* sink, size_t limit);
+  void CollectCoverageTo(Coverage* coverage);
+
+  // Decision log: random numbers tagged with step, actor and call site
+
+  void RecordDecisionsTo(std::string fpath);
+  // Panics at the first divergence from recorded simulation
+  void ReplayDecisionsFrom(std::string fpath);
+  // Fast-forward with logging disabled
+  void LogFromStep(size_t step);
+
+  // Rolling state digests for determinism checks
+  void RecordCheckpointsTo(Checkpoints* sink, CheckpointOptions options);
+
   void Start();
 
   bool Step();
   void MakeSteps(size_t count);
 
+  // Steps until `done` holds (checked before each step) or deadlock
+  // Unlike `Step` loop, quiescent periods are skipped in bulk
+  void RunUntil(std::function<bool()> done);
+
   // For tests
   void RestartServer(const std::string& hostname);
 
   // Returns simulation digest
   size_t Stop();
 
+  // Invoked at the end of `Stop` (see TestRunner::Configure)
+  using StopHook = std::function<void(const World& world)>;
+  void OnStop(StopHook hook);
+
   size_t Digest() const;
 
   size_t StepCount() const;
+  // Steps made in bulk, without separate next step search
+  size_t SkippedSteps() const;
   Jiffies TimeElapsed() const;
 
   const log::EventLog& EventLog() const;
@@ -139,15 +243,27 @@ class World {
 
   std::vector<std::string> GetStdout(const std::string& hostname) const;
 
+  // Cumulative over server restarts
+  db::BlockCacheStats GetDbCacheStats(const std::string& hostname) const;
+  db::ReplayStats GetDbReplayStats(const std::string& hostname) const;
+
+  // Cumulative over server restarts
+  process::CpuStats GetCpuStats(const std::string& hostname) const;
+
+  net::LinkStats GetNetworkStats() const;
+  // Cumulative over server restarts
+  net::TransportStats GetTransportStats(const std::string& hostname) const;
+
  private:
   void AddPool(std::string pool_name, node::program::Main program, size_t size,
-               std::string server_name_template);
+               std::string server_name_template, ServerOptions options);
 
   void SetGlobalImpl(const std::string& key, std::any value);
   std::any GetGlobalImpl(const std::string& key) const;
 
  private:
   std::unique_ptr<matrix::World> impl_;
+  StopHook stop_hook_;
 };
 
 }  // namespace whirl::matrix::facade
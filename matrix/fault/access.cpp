@@ -5,7 +5,7 @@
 namespace whirl::matrix::fault {
 
 IFaultyServer& Server(const std::string& hostname) {
-  return World::Access()->GetServer(hostname);
+  return World::Access()->GetFaultyServer(hostname);
 }
 
 IFaultyNetwork& Network() {
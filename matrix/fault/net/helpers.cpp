@@ -1,12 +1,12 @@
 #include <matrix/fault/net/helpers.hpp>
 
-#include <whirl/node/runtime/shortcuts.hpp>
+#include <matrix/world/global/random.hpp>
 
 namespace whirl::matrix::fault::net {
 
-void Shuffle(std::vector<std::string>& pool) {
+void Shuffle(std::vector<std::string>& pool, std::source_location site) {
   for (size_t i = 0; i + 1 < pool.size(); ++i) {
-    int j = node::rt::RandomNumber(i, pool.size() - 1);
+    int j = GlobalRandomNumber(i, pool.size(), site);
     std::swap(pool[i], pool[j]);
   }
 }
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <source_location>
 #include <vector>
 #include <string>
 
 namespace whirl::matrix::fault::net {
 
-void Shuffle(std::vector<std::string>& pool);
+void Shuffle(std::vector<std::string>& pool,
+             std::source_location site = std::source_location::current());
 
 }  // namespace whirl::matrix::fault::net
@@ -0,0 +1,19 @@
+#include <matrix/fault/net/lossy.hpp>
+
+#include <matrix/fault/access.hpp>
+
+namespace whirl::matrix::fault {
+
+void MakeLossy(std::vector<std::string> pool, LinkFaults faults) {
+  auto& net = Network();
+
+  for (const auto& start : pool) {
+    for (const auto& end : pool) {
+      if (start != end) {
+        net.SetLinkFaults(start, end, faults);
+      }
+    }
+  }
+}
+
+}  // namespace whirl::matrix::fault
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <matrix/fault/network.hpp>
+
+#include <string>
+#include <vector>
+
+namespace whirl::matrix::fault {
+
+// Set `faults` for all links between servers in `pool`
+void MakeLossy(std::vector<std::string> pool, LinkFaults faults);
+
+}  // namespace whirl::matrix::fault
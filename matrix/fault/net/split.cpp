@@ -1,18 +1,20 @@
 #include <matrix/fault/net/split.hpp>
 
-#include <whirl/node/runtime/shortcuts.hpp>
-
 #include <matrix/fault/access.hpp>
 
+#include <matrix/world/global/random.hpp>
+
 #include <set>
 
 namespace whirl::matrix::fault {
 
-static std::set<std::string> GenerateSplit(std::vector<std::string> pool, size_t lhs_size) {
+static std::set<std::string> GenerateSplit(std::vector<std::string> pool,
+                                           size_t lhs_size,
+                                           std::source_location site) {
   std::set<std::string> lhs;
 
   for (size_t i = 0; i < lhs_size; ++i) {
-    size_t j = node::rt::RandomNumber(i, pool.size() - 1);
+    size_t j = GlobalRandomNumber(i, pool.size(), site);
     std::swap(pool[i], pool[j]);
     lhs.insert(pool[i]);
   }
@@ -20,8 +22,9 @@ static std::set<std::string> GenerateSplit(std::vector<std::string> pool, size_t
   return lhs;
 }
 
-void RandomSplit(std::vector<std::string> pool, size_t lhs_size) {
-  auto lhs = GenerateSplit(pool, lhs_size);
+void RandomSplit(std::vector<std::string> pool, size_t lhs_size,
+                 std::source_location site) {
+  auto lhs = GenerateSplit(pool, lhs_size, site);
 
   auto& net = Network();
 
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <cstdlib>
+#include <source_location>
 #include <string>
 #include <vector>
 
 namespace whirl::matrix::fault {
 
-void RandomSplit(std::vector<std::string> pool, size_t lhs);
+void RandomSplit(std::vector<std::string> pool, size_t lhs,
+                 std::source_location site = std::source_location::current());
 
 }  // namespace whirl::matrix::fault
@@ -1,9 +1,9 @@
 #include <matrix/fault/net/star.hpp>
 
-#include <whirl/node/runtime/shortcuts.hpp>
-
 #include <matrix/fault/access.hpp>
 
+#include <matrix/world/global/random.hpp>
+
 namespace whirl::matrix::fault {
 
 void MakeStar(std::vector<std::string> pool, size_t center) {
@@ -18,8 +18,9 @@ void MakeStar(std::vector<std::string> pool, size_t center) {
   }
 }
 
-void MakeRandomStar(std::vector<std::string> pool) {
-  size_t center = node::rt::RandomNumber(pool.size());
+void MakeRandomStar(std::vector<std::string> pool,
+                    std::source_location site) {
+  size_t center = GlobalRandomNumber(pool.size(), site);
   MakeStar(std::move(pool), center);
 }
 
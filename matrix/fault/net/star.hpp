@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdlib>
+#include <source_location>
 #include <string>
 #include <vector>
 
@@ -8,6 +9,8 @@ namespace whirl::matrix::fault {
 
 void MakeStar(std::vector<std::string> pool, size_t center);
 
-void MakeRandomStar(std::vector<std::string> pool);
+void MakeRandomStar(
+    std::vector<std::string> pool,
+    std::source_location site = std::source_location::current());
 
 }  // namespace whirl::matrix::fault
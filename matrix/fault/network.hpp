@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <set>
 #include <vector>
@@ -14,6 +15,21 @@ using Partition = std::set<std::string>;
 
 //////////////////////////////////////////////////////////////////////
 
+// Probabilistic faults of one-way link
+// Applied to data packets, driven by world randomness
+
+struct LinkFaults {
+  // Probabilities in [0, 1]
+  double drop = 0;
+  double duplicate = 0;
+
+  // Random extra delay in [0, reorder_window] jiffies,
+  // later packets can overtake earlier ones
+  uint64_t reorder_window = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
 struct IFaultyNetwork {
   virtual ~IFaultyNetwork() = default;
 
@@ -29,6 +45,14 @@ struct IFaultyNetwork {
 
   // After Split
   virtual void Heal() = 0;
+
+  // Loss / duplication / reordering
+
+  virtual void SetLinkFaults(const std::string& start, const std::string& end,
+                             const LinkFaults& faults) = 0;
+
+  // Reset faults of all links
+  virtual void ClearLinkFaults() = 0;
 };
 
 }  // namespace whirl::matrix::fault
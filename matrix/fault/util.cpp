@@ -2,17 +2,20 @@
 
 #include <matrix/fault/access.hpp>
 
+#include <matrix/world/global/random.hpp>
+
 #include <whirl/node/runtime/shortcuts.hpp>
 
 namespace whirl::matrix::fault {
 
-void RandomPause(Jiffies lo, Jiffies hi) {
-  auto delay = node::rt::RandomNumber(lo.Count(), hi.Count());
+void RandomPause(Jiffies lo, Jiffies hi, std::source_location site) {
+  auto delay = GlobalRandomNumber(lo.Count(), hi.Count() + 1, site);
   node::rt::SleepFor({delay});
 }
 
-IFaultyServer& RandomServer(const std::vector<std::string>& hosts) {
-  auto hostname = hosts.at(node::rt::RandomNumber(hosts.size()));
+IFaultyServer& RandomServer(const std::vector<std::string>& hosts,
+                            std::source_location site) {
+  auto hostname = hosts.at(GlobalRandomNumber(hosts.size(), site));
   return matrix::fault::Server(hostname);
 }
 
@@ -4,13 +4,20 @@
 
 #include <whirl/node/time/jiffies.hpp>
 
+#include <source_location>
 #include <string>
 #include <vector>
 
 namespace whirl::matrix::fault {
 
-void RandomPause(Jiffies lo, Jiffies hi);
+// Random decisions are recorded at the call site
 
-IFaultyServer& RandomServer(const std::vector<std::string>& hosts);
+// [lo, hi]
+void RandomPause(Jiffies lo, Jiffies hi,
+                 std::source_location site = std::source_location::current());
+
+IFaultyServer& RandomServer(
+    const std::vector<std::string>& hosts,
+    std::source_location site = std::source_location::current());
 
 }  // namespace whirl::matrix::fault
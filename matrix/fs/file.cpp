@@ -3,7 +3,8 @@
 #include <wheels/io/memory.hpp>
 
 #include <wheels/memory/view_of.hpp>
-#include <wheels/support/hash.hpp>
+
+#include <algorithm>
 
 namespace whirl::matrix::fs {
 
@@ -12,7 +13,22 @@ size_t File::Size() const {
 }
 
 void File::Truncate(size_t new_size) {
+  size_t curr_size = data_.size();
   data_.resize(new_size, 0);
+
+  if (new_size >= curr_size) {
+    // Zero-filled extension
+    static const char kZeros[64] = {};
+    for (size_t left = new_size - curr_size; left > 0;) {
+      size_t chunk = std::min(left, sizeof(kZeros));
+      digest_.EatBytes(kZeros, chunk);
+      left -= chunk;
+    }
+  } else {
+    // Rare: rehash remaining prefix
+    digest_ = {};
+    digest_.EatBytes(data_.data(), data_.size());
+  }
 }
 
 void File::Append(wheels::ConstMemView append) {
@@ -22,6 +38,8 @@ void File::Append(wheels::ConstMemView append) {
   // Write
   data_.resize(new_size);
   memcpy(/*to=*/&data_[curr_size], /*from=*/append.Data(), append.Size());
+
+  digest_.EatBytes(append.Data(), append.Size());
 }
 
 wheels::ConstMemView File::Tail(size_t offset) const {
@@ -38,8 +56,4 @@ size_t File::PRead(size_t offset, wheels::MutableMemView buffer) const {
   return reader.Read(buffer);
 }
 
-size_t File::ComputeDigest() const {
-  return wheels::HashRange(17, wheels::ViewOf(data_));
-}
-
 }  // namespace whirl::matrix::fs
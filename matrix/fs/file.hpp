@@ -1,5 +1,7 @@
 #pragma once
 
+#include <matrix/helpers/digest.hpp>
+
 #include <wheels/memory/view.hpp>
 
 #include <vector>
@@ -13,13 +15,18 @@ class File {
   void Append(wheels::ConstMemView data);
   size_t PRead(size_t offset, wheels::MutableMemView buffer) const;
 
-  size_t ComputeDigest() const;
+  // O(1), maintained on writes
+  Digest128 ComputeDigest() const {
+    return digest_.GetDigest();
+  }
 
  private:
   wheels::ConstMemView Tail(size_t offset) const;
 
  private:
   std::vector<char> data_;
+  // Digest of `data_`
+  DigestCalculator digest_;
 };
 
 }  // namespace whirl::matrix::fs
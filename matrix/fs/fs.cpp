@@ -58,6 +58,19 @@ Result<size_t> FileSystem::Read(Fd fd, wheels::MutableMemView buffer) {
   return result::Ok(bytes_read);
 }
 
+Result<size_t> FileSystem::PRead(Fd fd, size_t offset,
+                                 wheels::MutableMemView buffer) {
+  GlobalAllocatorGuard g;
+
+  OpenedFile& of = GetOpenedFile(fd);
+  CheckMode(of, FileMode::Read);
+
+  LOG_DEBUG("Read {} bytes from '{}' at offset {}", buffer.Size(), of.path,
+            offset);
+  size_t bytes_read = of.file->PRead(offset, buffer);
+  return result::Ok(bytes_read);
+}
+
 Status FileSystem::Append(Fd fd, wheels::ConstMemView data) {
   GlobalAllocatorGuard g;
 
@@ -225,14 +238,15 @@ void FileSystem::Reset() {
   next_fd_ = 0;
 }
 
-size_t FileSystem::ComputeDigest() const {
+Digest128 FileSystem::ComputeDigest() const {
   DigestCalculator digest;
 
+  // File digests are maintained on writes
   for (const auto& [path, file] : files_) {
     digest.Eat(path);
     digest.Combine(file->ComputeDigest());
   }
-  return digest.GetValue();
+  return digest.GetDigest();
 }
 
 }  // namespace whirl::matrix::fs
@@ -75,6 +75,9 @@ class FileSystem {
                                     persist::fs::FileMode mode);
 
   wheels::Result<size_t> Read(persist::fs::Fd fd, wheels::MutableMemView buffer);
+  // Positional read, does not move file offset
+  wheels::Result<size_t> PRead(persist::fs::Fd fd, size_t offset,
+                               wheels::MutableMemView buffer);
   wheels::Status Append(persist::fs::Fd fd, wheels::ConstMemView data);
   wheels::Status Sync(persist::fs::Fd fd);
   wheels::Status Close(persist::fs::Fd fd);
@@ -98,7 +101,7 @@ class FileSystem {
   // On crash
   void Reset();
 
-  size_t ComputeDigest() const;
+  Digest128 ComputeDigest() const;
 
  private:
   FileRef FindOrCreateFile(const persist::fs::Path& file_path,
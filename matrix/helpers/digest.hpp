@@ -1,32 +1,237 @@
 #pragma once
 
-#include <wheels/support/hash.hpp>
-
+#include <cstdint>
 #include <cstdlib>
-#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace whirl {
 
+//////////////////////////////////////////////////////////////////////
+
+// Portable across compilers and standard libraries:
+// do not use std::hash here
+
+struct Digest128 {
+  uint64_t lo{0};
+  uint64_t hi{0};
+
+  bool operator==(const Digest128& that) const = default;
+
+  // Folded to 64 bits
+  uint64_t Fold() const {
+    return lo ^ (hi * 0x9E3779B97F4A7C15ull);
+  }
+
+  std::string ToString() const {
+    static const char* kHex = "0123456789abcdef";
+
+    std::string str(32, '0');
+    for (size_t i = 0; i < 16; ++i) {
+      str[15 - i] = kHex[(hi >> (4 * i)) & 0xF];
+      str[31 - i] = kHex[(lo >> (4 * i)) & 0xF];
+    }
+    return str;
+  }
+};
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+inline uint64_t Rotl(uint64_t x, int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+// 64 x 64 -> 128 multiplication, high and low halves folded
+inline uint64_t Mum(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+  return static_cast<uint64_t>(r >> 64) ^ static_cast<uint64_t>(r);
+#else
+  uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+  uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+
+  uint64_t lo_lo = a_lo * b_lo;
+  uint64_t hi_lo = a_hi * b_lo;
+  uint64_t lo_hi = a_lo * b_hi;
+  uint64_t hi_hi = a_hi * b_hi;
+
+  uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+  uint64_t hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+  uint64_t lo = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+  return hi ^ lo;
+#endif
+}
+
+inline uint64_t Avalanche(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xC2B2AE3D27D4EB4Full;
+  x ^= x >> 29;
+  x *= 0x165667B19E3779F9ull;
+  x ^= x >> 32;
+  return x;
+}
+
+// Little-endian on every platform
+inline uint64_t LoadWord(const unsigned char* bytes, size_t size) {
+  uint64_t word = 0;
+  for (size_t i = 0; i < size; ++i) {
+    word |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+  return word;
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Streaming 128-bit digest
+// Two independent 64-bit lanes:
+// xxh64-style round and wyhash-style multiply-fold
+
 class DigestCalculator {
   using Self = DigestCalculator;
 
+  static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+  static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+  static constexpr uint64_t kSecret0 = 0xA0761D6478BD642Full;
+  static constexpr uint64_t kSecret1 = 0xE7037ED1A0B428DBull;
+
  public:
-  Self& Combine(size_t hash_value) {
-    wheels::HashCombine(digest_, hash_value);
-    return *this;
+  Self& Combine(uint64_t hash_value) {
+    return AbsorbWord(hash_value);
+  }
+
+  Self& Combine(const Digest128& digest) {
+    return AbsorbWord(digest.lo).AbsorbWord(digest.hi);
   }
 
+  // Integers and enums, by value
   template <typename T>
-  Self& Eat(const T& object) {
-    return Combine(std::hash<T>()(object));
+  Self& Eat(T value) {
+    static_assert(std::is_integral_v<T> || std::is_enum_v<T>,
+                  "Only integers, enums and strings are supported");
+
+    if constexpr (std::is_enum_v<T>) {
+      using U = std::underlying_type_t<T>;
+      return AbsorbWord(static_cast<uint64_t>(static_cast<U>(value)));
+    } else {
+      return AbsorbWord(static_cast<uint64_t>(value));
+    }
+  }
+
+  Self& Eat(std::string_view str) {
+    AbsorbWord(str.size());
+    EatBytes(str.data(), str.size());
+    return Flush();
+  }
+
+  Self& Eat(const std::string& str) {
+    return Eat(std::string_view{str});
+  }
+
+  Self& Eat(const char* str) {
+    return Eat(std::string_view{str});
+  }
+
+  // Raw byte stream: feeding bytes in one call or in several
+  // consecutive calls yields the same digest
+  Self& EatBytes(const void* data, size_t size) {
+    auto* bytes = static_cast<const unsigned char*>(data);
+
+    // Complete pending word
+    while (size > 0 && pending_size_ > 0) {
+      EatByte(*bytes++);
+      --size;
+    }
+
+    // Whole words
+    for (; size >= 8; bytes += 8, size -= 8) {
+      Absorb(detail::LoadWord(bytes, 8));
+    }
+
+    // Tail
+    for (; size > 0; --size) {
+      EatByte(*bytes++);
+    }
+
+    return *this;
+  }
+
+  Digest128 GetDigest() const {
+    uint64_t lane0 = lane0_;
+    uint64_t lane1 = lane1_;
+
+    if (pending_size_ > 0) {
+      lane0 = Round0(lane0, pending_);
+      lane1 = Round1(lane1, pending_ ^ pending_size_);
+    }
+
+    lane0 ^= bytes_;
+    lane1 ^= detail::Rotl(bytes_, 32);
+
+    Digest128 digest;
+    digest.lo = detail::Avalanche(lane0 + detail::Mum(lane1, kPrime1));
+    digest.hi = detail::Avalanche(lane1 ^ digest.lo);
+    return digest;
   }
 
-  size_t GetValue() const {
-    return digest_;
+  uint64_t GetValue() const {
+    return GetDigest().Fold();
   }
 
  private:
-  size_t digest_{0};
+  static uint64_t Round0(uint64_t lane, uint64_t word) {
+    return detail::Rotl(lane + word * kPrime2, 31) * kPrime1;
+  }
+
+  static uint64_t Round1(uint64_t lane, uint64_t word) {
+    return detail::Mum(lane ^ word ^ kSecret0, kSecret1);
+  }
+
+  void Absorb(uint64_t word) {
+    lane0_ = Round0(lane0_, word);
+    lane1_ = Round1(lane1_, word);
+    bytes_ += 8;
+  }
+
+  void EatByte(unsigned char byte) {
+    pending_ |= static_cast<uint64_t>(byte) << (8 * pending_size_);
+    if (++pending_size_ == 8) {
+      uint64_t word = pending_;
+      pending_ = 0;
+      pending_size_ = 0;
+      Absorb(word);
+    }
+  }
+
+  // Aligns stream to a word boundary
+  Self& Flush() {
+    if (pending_size_ > 0) {
+      uint64_t word = pending_ ^ (pending_size_ << 56);
+      pending_ = 0;
+      pending_size_ = 0;
+      Absorb(word);
+    }
+    return *this;
+  }
+
+  Self& AbsorbWord(uint64_t word) {
+    Flush();
+    Absorb(word);
+    return *this;
+  }
+
+ private:
+  uint64_t lane0_{kPrime1};
+  uint64_t lane1_{kSecret1};
+  uint64_t bytes_{0};
+
+  // Partial word of a byte stream
+  uint64_t pending_{0};
+  uint64_t pending_size_{0};
 };
 
 }  // namespace whirl
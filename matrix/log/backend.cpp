@@ -13,6 +13,14 @@ LogBackend::LogBackend() {
 }
 
 void LogBackend::Write(const Event& event) {
+  if (coverage_ != nullptr) {
+    // Log site ~ component + message with digits skipped
+    std::string site = event.component;
+    site += ':';
+    site += event.message;
+    coverage_->Hit(Coverage::MakePoint(event.actor, site));
+  }
+
   events_.push_back(event);
 
   if (file_.has_value()) {
@@ -35,6 +43,10 @@ timber::Level LogBackend::GetMinLevelFor(const std::string& component) const {
 }
 
 void LogBackend::Log(timber::Event event) {
+  if (muted_) {
+    return;
+  }
+
   GlobalAllocatorGuard g;
   Write(CaptureMatrixContext(event));
 }
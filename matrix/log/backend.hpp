@@ -3,6 +3,8 @@
 #include <matrix/log/event.hpp>
 #include <matrix/log/env.hpp>
 
+#include <matrix/world/coverage.hpp>
+
 #include <timber/backend.hpp>
 
 #include <optional>
@@ -27,6 +29,16 @@ class LogBackend : public timber::ILogBackend {
 
   void AppendToFile(const std::string& path);
 
+  // Fast-forward
+  void Mute(bool on) {
+    muted_ = on;
+  }
+
+  // Log sites are coverage points
+  void CollectCoverageTo(Coverage* coverage) {
+    coverage_ = coverage;
+  }
+
   const EventLog& GetEvents() const {
     return events_;
   }
@@ -41,6 +53,10 @@ class LogBackend : public timber::ILogBackend {
 
   EventLog events_;
   std::optional<std::ofstream> file_;
+
+  Coverage* coverage_{nullptr};
+
+  bool muted_{false};
 };
 
 }  // namespace whirl::matrix::log
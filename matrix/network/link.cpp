@@ -5,6 +5,7 @@
 #include <matrix/world/global/time.hpp>
 #include <matrix/world/global/time_model.hpp>
 #include <matrix/world/global/log.hpp>
+#include <matrix/world/global/random.hpp>
 
 #include <matrix/log/bytes.hpp>
 
@@ -12,18 +13,92 @@
 
 #include <wheels/support/assert.hpp>
 
+#include <algorithm>
+
 namespace whirl::matrix::net {
 
 Link::Link(Network* net, IServer* start, IServer* end)
-    : net_(net), start_(start), end_(end), logger_("Network", GetLogBackend()) {
+    : net_(net),
+      start_(start),
+      end_(end),
+      params_(net->GetLinkParams(start->HostName(), end->HostName())),
+      logger_("Network", GetLogBackend()) {
+}
+
+// Link layer overhead
+static const size_t kPacketHeaderBytes = 40;
+
+static size_t PacketSize(const Packet& packet) {
+  return kPacketHeaderBytes + packet.message.size();
 }
 
 void Link::Add(Packet packet) {
-  if (packet.header.type == Packet::Type::Data) {
+  const bool data = packet.header.type == Packet::Type::Data;
+
+  if (data) {
     Address to{End()->HostName(), packet.header.dest_port};
     LOG_INFO("Send packet to {}: {}", to, log::FormatMessage(packet.message));
   }
-  Add(MakeFrame(packet), ChooseDeliveryTime(packet));
+
+  const size_t bytes = PacketSize(packet);
+
+  ++stats_.packets;
+  stats_.bytes += bytes;
+
+  if (Congested(bytes)) {
+    if (params_.queue_policy == LinkParams::QueuePolicy::Ecn) {
+      if (data) {
+        // Receiver echoes mark back to sender, see Transport
+        packet.header.ce = true;
+        ++stats_.ecn_marks;
+      }
+    } else if (data) {
+      // Service packets (ping / reset) are never dropped
+      LOG_WARN("Transmission queue {} -> {} is full, drop packet",
+               Start()->HostName(), End()->HostName());
+      ++stats_.tail_drops;
+      Lost(packet);
+      return;
+    }
+  }
+
+  if (data && DropPacket()) {
+    LOG_WARN("Drop packet on link {} -> {}", Start()->HostName(),
+             End()->HostName());
+    ++stats_.drops;
+    Lost(packet);
+    return;
+  }
+
+  Frame frame = MakeFrame(packet);
+
+  const TimePoint sent = Transmit(bytes);
+
+  if (data && DuplicatePacket()) {
+    ++stats_.duplicates;
+
+    // Only the original is acked / echoes congestion mark,
+    // otherwise sender would see the same bytes acked twice
+    Frame duplicate = frame;
+    duplicate.packet.header.need_ack = false;
+    duplicate.packet.header.ce = false;
+
+    TimePoint delivery_time = ChooseDeliveryTime(packet, sent);
+    delivery_time += ReorderDelay();
+    Add(std::move(duplicate), delivery_time);
+  }
+
+  // Sequenced: both consume randomness
+  TimePoint delivery_time = ChooseDeliveryTime(packet, sent);
+  delivery_time += ReorderDelay();
+  Add(std::move(frame), delivery_time);
+}
+
+void Link::Lost(const Packet& packet) {
+  if (packet.header.need_ack) {
+    // Sender detects loss, otherwise its send window would leak
+    opposite_->Add(MakeAck(packet.header, packet.message.size()));
+  }
 }
 
 Frame Link::MakeFrame(Packet packet) {
@@ -31,19 +106,97 @@ Frame Link::MakeFrame(Packet packet) {
           std::move(packet)};
 }
 
-TimePoint Link::ChooseDeliveryTime(const Packet& packet) const {
+bool Link::Congested(size_t bytes) {
+  if (params_.bandwidth == 0 || params_.buffer_bytes == 0 || IsLoopBack()) {
+    return false;
+  }
+
+  // Remove transmitted packets
+  const auto now = GlobalNow();
+  while (!tx_queue_.empty() && tx_queue_.front().first <= now) {
+    tx_queue_bytes_ -= tx_queue_.front().second;
+    tx_queue_.pop_front();
+  }
+
+  return tx_queue_bytes_ + bytes > params_.buffer_bytes;
+}
+
+TimePoint Link::Transmit(size_t bytes) {
+  const auto now = GlobalNow();
+
+  if (params_.bandwidth == 0 || IsLoopBack()) {
+    return now;
+  }
+
+  // Serialization delay, packets are sent one by one
+  const TimePoint start = std::max(now, busy_until_);
+  busy_until_ = start + (bytes + params_.bandwidth - 1) / params_.bandwidth;
+
+  if (params_.buffer_bytes > 0) {
+    tx_queue_.emplace_back(busy_until_, bytes);
+    tx_queue_bytes_ += bytes;
+  }
+
+  return busy_until_;
+}
+
+TimePoint Link::ChooseDeliveryTime(const Packet& packet,
+                                   TimePoint sent) const {
   const auto flight_time = TimeModel()->FlightTime(Start(), End(), packet);
-  return GlobalNow() + flight_time.Count();
+  const auto wan_delay = net_->GetTopology().ExtraFlightTime(Start(), End());
+  return sent + flight_time.Count() + wan_delay.Count();
+}
+
+// Faults
+
+// Does not consume randomness if p = 0
+static bool Bernoulli(double p) {
+  static const uint64_t kScale = 1'000'000;
+
+  if (p <= 0) {
+    return false;
+  }
+  return GlobalRandomNumber(kScale) < p * kScale;
+}
+
+bool Link::DropPacket() {
+  return Bernoulli(faults_.drop);
+}
+
+bool Link::DuplicatePacket() {
+  return Bernoulli(faults_.duplicate);
+}
+
+TimePoint Link::ReorderDelay() {
+  if (faults_.reorder_window == 0) {
+    return 0;
+  }
+  TimePoint delay = GlobalRandomNumber(faults_.reorder_window + 1);
+  if (delay > 0) {
+    ++stats_.reordered;
+  }
+  return delay;
 }
 
 Frame Link::ExtractNextFrame() {
   WHEELS_VERIFY(!paused_, "Link is paused");
-  return frames_.Extract().frame;
+
+  Frame frame = frames_.Extract().frame;
+
+  Unschedule();
+  if (HasFrames()) {
+    // Overdue frames (after Resume) are delivered one by one
+    ScheduleAt(std::max(NextFrameTime(), GlobalNow()));
+  }
+
+  return frame;
 }
 
 void Link::Pause() {
   WHEELS_VERIFY(!paused_, "Link is already paused");
   paused_ = true;
+  // Leave network event queue
+  Unschedule();
 }
 
 void Link::Resume() {
@@ -53,19 +206,31 @@ void Link::Resume() {
 
   paused_ = false;
 
-  auto now = GlobalNow();
-
-  if (!frames_.IsEmpty()) {
-    while (frames_.Smallest().time < now) {
-      Add(frames_.Extract().frame, now + 1);
-    }
+  if (HasFrames()) {
+    ScheduleAt(std::max(NextFrameTime(), GlobalNow() + 1));
   }
 }
 
 void Link::Add(Frame frame, TimePoint delivery_time) {
-  frames_.Insert({frame, delivery_time});
-  net_->AddLinkEvent(this, delivery_time);
   net_->LogFrame(frame);
+  frames_.Insert({std::move(frame), delivery_time});
+
+  if (!paused_ && (!scheduled_ || delivery_time < scheduled_time_)) {
+    ScheduleAt(delivery_time);
+  }
+}
+
+void Link::ScheduleAt(TimePoint time) {
+  scheduled_ = true;
+  scheduled_time_ = time;
+  // Supersede previous event
+  ++epoch_;
+  net_->AddLinkEvent(this, time, epoch_);
+}
+
+void Link::Unschedule() {
+  scheduled_ = false;
+  ++epoch_;
 }
 
 }  // namespace whirl::matrix::net
@@ -5,12 +5,17 @@
 #include <matrix/network/packet.hpp>
 #include <matrix/network/server.hpp>
 #include <matrix/network/frame.hpp>
+#include <matrix/network/link_params.hpp>
+#include <matrix/network/stats.hpp>
 #include <matrix/trace/tracer.hpp>
+#include <matrix/fault/network.hpp>
 
 #include <matrix/helpers/priority_queue.hpp>
 
 #include <timber/logger.hpp>
 
+#include <deque>
+
 namespace whirl::matrix::net {
 
 class Network;
@@ -52,6 +57,18 @@ class Link {
     return start_ == end_;
   }
 
+  void SetParams(const LinkParams& params) {
+    params_ = params;
+  }
+
+  void SetFaults(const fault::LinkFaults& faults) {
+    faults_ = faults;
+  }
+
+  const LinkStats& Stats() const {
+    return stats_;
+  }
+
   void Add(Packet packet);
 
   bool IsPaused() const {
@@ -66,10 +83,18 @@ class Link {
     return frames_.Smallest().time;
   }
 
+  // Reschedules link for the next frame
   Frame ExtractNextFrame();
 
+  // Network event queue holds at most one live event per link,
+  // superseded events are skipped lazily
+  bool IsLiveEvent(uint64_t epoch) const {
+    return scheduled_ && epoch == epoch_;
+  }
+
   void Shutdown() {
     frames_.Clear();
+    Unschedule();
   }
 
   // Faults
@@ -79,19 +104,51 @@ class Link {
 
  private:
   Frame MakeFrame(Packet packet);
+  // Dropped packet
+  void Lost(const Packet& packet);
 
-  TimePoint ChooseDeliveryTime(const Packet& packet) const;
+  // Transmission queue
+
+  bool Congested(size_t bytes);
+  // Returns time when packet leaves the sender
+  TimePoint Transmit(size_t bytes);
+
+  TimePoint ChooseDeliveryTime(const Packet& packet, TimePoint sent) const;
+
+  // Injected faults
+  bool DropPacket();
+  bool DuplicatePacket();
+  TimePoint ReorderDelay();
 
   void Add(Frame frame, TimePoint delivery_time);
 
+  // Network event queue
+  void ScheduleAt(TimePoint time);
+  void Unschedule();
+
  private:
   Network* net_;
   IServer* start_;
   IServer* end_;
 
+  LinkParams params_;
+  fault::LinkFaults faults_;
+
+  // Packets in transmission queue: (departure time, size)
+  std::deque<std::pair<TimePoint, size_t>> tx_queue_;
+  size_t tx_queue_bytes_{0};
+  TimePoint busy_until_{0};
+
   FrameQueue frames_;
   bool paused_{false};
 
+  // Live event in network queue
+  bool scheduled_{false};
+  TimePoint scheduled_time_{0};
+  uint64_t epoch_{0};
+
+  LinkStats stats_;
+
   Link* opposite_{nullptr};
 
   timber::Logger logger_;
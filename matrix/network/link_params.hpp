@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdlib>
+
+namespace whirl::matrix::net {
+
+// Physical properties of one-way link
+
+struct LinkParams {
+  enum class QueuePolicy {
+    TailDrop,  // Drop data packets that do not fit into buffer
+    Ecn,       // Deliver, but mark frame as congested
+  };
+
+  // Bytes per jiffy, 0 - unlimited (no serialization delay)
+  size_t bandwidth = 0;
+
+  // Transmission queue capacity in bytes, 0 - unbounded
+  size_t buffer_bytes = 0;
+
+  QueuePolicy queue_policy = QueuePolicy::TailDrop;
+};
+
+}  // namespace whirl::matrix::net
@@ -1,6 +1,7 @@
 #include <matrix/network/network.hpp>
 
 #include <matrix/new/new.hpp>
+#include <matrix/world/global/coverage.hpp>
 #include <matrix/world/global/time.hpp>
 #include <matrix/world/global/random.hpp>
 #include <matrix/world/global/trace.hpp>
@@ -10,6 +11,8 @@
 #include <wheels/support/assert.hpp>
 #include <wheels/support/compiler.hpp>
 
+#include <algorithm>
+
 namespace whirl::matrix::net {
 
 Network::Network(timber::ILogBackend* log)
@@ -17,40 +20,88 @@ Network::Network(timber::ILogBackend* log)
 }
 
 void Network::AddServer(IServer* server) {
+  server_index_.emplace(server->HostName(), servers_.size());
   servers_.push_back(server);
+  server_links_.emplace_back();
+  lhs_.push_back(false);
 }
 
-void Network::BuildLinks() {
-  // Create one-way link between each pair of servers
-  for (size_t i = 0; i < servers_.size(); ++i) {
-    for (size_t j = 0; j < servers_.size(); ++j) {
-      links_.emplace_back(this, servers_[i], servers_[j]);
-    }
+void Network::SetLinkParams(const HostName& start, const HostName& end,
+                            const LinkParams& params) {
+  link_params_.insert_or_assign({start, end}, params);
+  if (Link* link = FindLink(ServerToIndex(start), ServerToIndex(end))) {
+    link->SetParams(params);
   }
+}
 
-  // Link opposite physical links
-  for (size_t i = 0; i < servers_.size(); ++i) {
-    for (size_t j = i; j < servers_.size(); ++j) {
-      size_t ij = GetLinkIndex(i, j);
-      size_t ji = GetLinkIndex(j, i);
-
-      links_[ij].SetOpposite(&links_[ji]);
-      links_[ji].SetOpposite(&links_[ij]);
-    }
+LinkParams Network::GetLinkParams(const HostName& start,
+                                  const HostName& end) const {
+  auto it = link_params_.find({start, end});
+  if (it != link_params_.end()) {
+    return it->second;
   }
+  return default_link_params_;
 }
 
 Link* Network::GetLink(const HostName& start, const HostName& end) {
-  size_t i = ServerToIndex(start);
-  size_t j = ServerToIndex(end);
+  return GetLink(ServerToIndex(start), ServerToIndex(end));
+}
+
+Link* Network::GetLink(size_t i, size_t j) {
+  if (Link* link = FindLink(i, j)) {
+    return link;
+  }
+  return CreateLink(i, j);
+}
+
+Link* Network::FindLink(size_t i, size_t j) {
+  auto it = links_.find(GetLinkKey(i, j));
+  if (it != links_.end()) {
+    return &it->second;
+  }
+  return nullptr;
+}
+
+Link* Network::CreateLink(size_t i, size_t j) {
+  GlobalAllocatorGuard g;
+
+  auto make = [this](size_t start, size_t end) -> Link* {
+    auto [it, inserted] = links_.try_emplace(GetLinkKey(start, end), this,
+                                             servers_[start], servers_[end]);
+    WHEELS_VERIFY(inserted, "Link already exists");
+    Link* link = &it->second;
+
+    all_links_.push_back(link);
+    server_links_[start].push_back(link);
+    if (start != end) {
+      server_links_[end].push_back(link);
+    }
+
+    // Created during partition
+    if (Crosses(start, end)) {
+      PauseLink(link);
+    }
+
+    return link;
+  };
 
-  return &links_.at(GetLinkIndex(i, j));
+  Link* link = make(i, j);
+  if (i == j) {
+    link->SetOpposite(link);
+    return link;
+  }
+
+  Link* opposite = make(j, i);
+  link->SetOpposite(opposite);
+  opposite->SetOpposite(link);
+
+  return link;
 }
 
 // IActor
 
 void Network::Start() {
-  BuildLinks();
+  // Links are created on demand
 }
 
 bool Network::IsRunnable() const {
@@ -65,14 +116,13 @@ void Network::Step() {
   LinkEvent event = events_.Extract();
   Link* link = event.link;
 
-  if (link->IsPaused()) {
-    return;  // Skip this step
-  }
-
+  WHEELS_VERIFY(link->IsLiveEvent(event.epoch), "Broken net");
   WHEELS_VERIFY(link->HasFrames(), "Broken net");
-  WHEELS_VERIFY(link->NextFrameTime() == event.time, "Broken net");
+  WHEELS_VERIFY(link->NextFrameTime() <= event.time, "Broken net");
 
   Frame frame = link->ExtractNextFrame();
+  RemoveStaleEvents();
+
   auto packet = frame.packet;
 
   // ???
@@ -86,31 +136,47 @@ void Network::Step() {
   }
 
   IServer* receiver = link->End();
+  last_receiver_ = receiver;
   receiver->HandlePacket(packet, link->GetOpposite());
 }
 
-void Network::AddLinkEvent(Link* link, TimePoint t) {
-  events_.Insert({t, link});
+LinkStats Network::GetStats() const {
+  LinkStats total;
+  for (const Link* link : all_links_) {
+    total += link->Stats();
+  }
+  return total;
+}
+
+void Network::AddLinkEvent(Link* link, TimePoint t, uint64_t epoch) {
+  events_.Insert({t, link, epoch});
+}
+
+void Network::RemoveStaleEvents() {
+  while (!events_.IsEmpty()) {
+    const LinkEvent& head = events_.Smallest();
+    if (head.link->IsLiveEvent(head.epoch)) {
+      break;
+    }
+    events_.Extract();
+  }
 }
 
 void Network::Shutdown() {
   events_.Clear();
-  for (auto& link : links_) {
-    link.Shutdown();
+  for (Link* link : all_links_) {
+    link->Shutdown();
   }
 }
 
 size_t Network::ServerToIndex(const HostName& hostname) const {
-  for (size_t i = 0; i < servers_.size(); ++i) {
-    if (hostname == servers_[i]->HostName()) {
-      return i;
-    }
-  }
-  WHEELS_UNREACHABLE();
+  auto it = server_index_.find(hostname);
+  WHEELS_VERIFY(it != server_index_.end(), "Unknown host " << hostname);
+  return it->second;
 }
 
-size_t Network::GetLinkIndex(size_t i, size_t j) const {
-  return i * servers_.size() + j;
+uint64_t Network::GetLinkKey(size_t i, size_t j) {
+  return (static_cast<uint64_t>(i) << 32) | j;
 }
 
 // Partitions
@@ -119,49 +185,114 @@ static bool IsSystem(IServer* server) {
   return server->HostName()[0] == 'S';  // TODO
 }
 
-static bool Cross(const Link& link, const fault::Partition& lhs) {
-  return lhs.count(link.Start()->HostName()) !=
-         lhs.count(link.End()->HostName());
+bool Network::Crosses(size_t i, size_t j) const {
+  if (!split_ || i == j) {
+    return false;
+  }
+  if (!IsSystem(servers_[i]) || !IsSystem(servers_[j])) {
+    return false;
+  }
+  return lhs_[i] != lhs_[j];
+}
+
+void Network::PauseLink(Link* link) {
+  if (link->IsPaused()) {
+    return;
+  }
+  LOG_WARN("Pause link {} - {}", link->Start()->HostName(),
+           link->End()->HostName());
+  link->Pause();
+  paused_links_.push_back(link);
+}
+
+void Network::ResumeLink(Link* link) {
+  link->Resume();
+  auto it = std::find(paused_links_.begin(), paused_links_.end(), link);
+  if (it != paused_links_.end()) {
+    paused_links_.erase(it);
+  }
 }
 
 void Network::PauseLink(const HostName& start, const HostName& end) {
   GlobalAllocatorGuard g;
+  Cover("fault:pause_link");
 
-  LOG_WARN("Pause link {} - {}", start, end);
-  GetLink(start, end)->Pause();
+  PauseLink(GetLink(start, end));
+  RemoveStaleEvents();
 }
 
 void Network::ResumeLink(const HostName& start, const HostName& end) {
   GlobalAllocatorGuard g;
+  Cover("fault:resume_link");
 
   LOG_WARN("Resume link {} - {}", start, end);
-  GetLink(start, end)->Resume();
+  ResumeLink(GetLink(start, end));
 }
 
 void Network::Split(const fault::Partition& lhs) {
+  GlobalAllocatorGuard g;
+  Cover("fault:split");
+
   LOG_INFO("Network partitioned: {} / ?", lhs.size());
 
-  for (auto& link : links_) {
-    if (link.IsLoopBack()) {
-      continue;
-    }
-    if (!IsSystem(link.Start()) || !IsSystem(link.End())) {
-      continue;
-    }
-    if (Cross(link, lhs)) {
-      LOG_WARN("Pause link {} - {}", link.Start()->HostName(),
-               link.End()->HostName());
-      link.Pause();
+  split_ = true;
+  std::fill(lhs_.begin(), lhs_.end(), false);
+
+  std::vector<size_t> lhs_servers;
+  for (const auto& host : lhs) {
+    size_t i = ServerToIndex(host);
+    lhs_[i] = true;
+    lhs_servers.push_back(i);
+  }
+
+  // Only links adjacent to `lhs` can cross the partition
+  for (size_t i : lhs_servers) {
+    for (Link* link : server_links_[i]) {
+      size_t start = ServerToIndex(link->Start()->HostName());
+      size_t end = ServerToIndex(link->End()->HostName());
+      if (Crosses(start, end)) {
+        PauseLink(link);
+      }
     }
   }
+
+  RemoveStaleEvents();
+}
+
+void Network::SetLinkFaults(const HostName& start, const HostName& end,
+                            const fault::LinkFaults& faults) {
+  GlobalAllocatorGuard g;
+  Cover("fault:link_faults");
+
+  LOG_WARN("Set faults for link {} - {}: drop = {}, duplicate = {}, "
+           "reorder window = {}",
+           start, end, faults.drop, faults.duplicate, faults.reorder_window);
+  GetLink(start, end)->SetFaults(faults);
+}
+
+void Network::ClearLinkFaults() {
+  GlobalAllocatorGuard g;
+  Cover("fault:clear_link_faults");
+
+  LOG_INFO("Clear link faults");
+  for (Link* link : all_links_) {
+    link->SetFaults({});
+  }
 }
 
 void Network::Heal() {
   GlobalAllocatorGuard g;
+  Cover("fault:heal");
+
+  if (split_) {
+    split_ = false;
+    std::fill(lhs_.begin(), lhs_.end(), false);
+  }
 
-  for (auto& link : links_) {
-    link.Resume();
+  for (Link* link : paused_links_) {
+    link->Resume();
   }
+  paused_links_.clear();
 }
 
 }  // namespace whirl::matrix::net
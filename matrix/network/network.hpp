@@ -6,6 +6,9 @@
 
 #include <matrix/network/link.hpp>
 #include <matrix/network/server.hpp>
+#include <matrix/network/topology.hpp>
+#include <matrix/network/link_params.hpp>
+#include <matrix/network/stats.hpp>
 
 #include <matrix/helpers/digest.hpp>
 
@@ -16,6 +19,8 @@
 #include <deque>
 #include <vector>
 #include <set>
+#include <map>
+#include <unordered_map>
 
 namespace whirl::matrix::net {
 
@@ -31,6 +36,7 @@ class Network : public IActor,
   struct LinkEvent {
     TimePoint time;
     Link* link;
+    uint64_t epoch;
 
     bool operator<(const LinkEvent& that) const {
       return time < that.time;
@@ -50,9 +56,28 @@ class Network : public IActor,
 
   void AddServer(IServer* server);
 
-  // After `BuildLinks`
+  // Links are created lazily on first use
   Link* GetLink(const HostName& start, const HostName& end);
 
+  Topology& GetTopology() {
+    return topology_;
+  }
+
+  const Topology& GetTopology() const {
+    return topology_;
+  }
+
+  // Link params
+
+  void SetDefaultLinkParams(const LinkParams& params) {
+    default_link_params_ = params;
+  }
+
+  void SetLinkParams(const HostName& start, const HostName& end,
+                     const LinkParams& params);
+
+  LinkParams GetLinkParams(const HostName& start, const HostName& end) const;
+
   // IActor
 
   const std::string& Name() const override {
@@ -82,6 +107,12 @@ class Network : public IActor,
   void Split(const fault::Partition& lhs) override;
   void Heal() override;
 
+  // - Loss / duplication / reordering
+
+  void SetLinkFaults(const HostName& start, const HostName& end,
+                     const fault::LinkFaults& faults) override;
+  void ClearLinkFaults() override;
+
   // INetworkListener
 
   size_t FrameCount() const override {
@@ -98,23 +129,61 @@ class Network : public IActor,
 
   // Misc
 
-  size_t Digest() const {
-    return digest_.GetValue();
+  Digest128 Digest() const {
+    return digest_.GetDigest();
+  }
+
+  // Total over all links
+  LinkStats GetStats() const;
+
+  // Receiver of the packet delivered at the last step
+  IServer* LastReceiver() const {
+    return last_receiver_;
   }
 
  private:
-  void AddLinkEvent(Link* link, TimePoint t);
+  void AddLinkEvent(Link* link, TimePoint t, uint64_t epoch);
+  // Keeps live event at the head of the queue
+  void RemoveStaleEvents();
 
   size_t ServerToIndex(const HostName& server) const;
-  size_t GetLinkIndex(size_t i, size_t j) const;
+  static uint64_t GetLinkKey(size_t i, size_t j);
 
-  // After all `AddServer`
-  void BuildLinks();
+  Link* GetLink(size_t i, size_t j);
+  Link* FindLink(size_t i, size_t j);
+  // Creates a pair of opposite links
+  Link* CreateLink(size_t i, size_t j);
+
+  // Partitions
+  bool Crosses(size_t i, size_t j) const;
+  void PauseLink(Link* link);
+  void ResumeLink(Link* link);
 
  private:
+  Topology topology_;
+
+  LinkParams default_link_params_;
+  std::map<std::pair<HostName, HostName>, LinkParams> link_params_;
+
   std::vector<IServer*> servers_;
-  std::vector<Link> links_;
+  std::unordered_map<HostName, size_t> server_index_;
+
+  // (start index, end index) -> link
+  std::unordered_map<uint64_t, Link> links_;
+  // Existing links for each server (both directions), in creation order
+  std::vector<std::vector<Link*>> server_links_;
+  // In creation order
+  std::vector<Link*> all_links_;
+
+  // Current partition: side of each server
+  bool split_{false};
+  std::vector<bool> lhs_;
+
+  // Paused by faults, resumed by `Heal`
+  std::vector<Link*> paused_links_;
+
   LinkEvents events_;
+  IServer* last_receiver_{nullptr};
 
   std::deque<Frame> frames_log_;
 
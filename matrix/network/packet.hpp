@@ -4,13 +4,19 @@
 #include <matrix/network/message.hpp>
 #include <matrix/network/timestamp.hpp>
 
+#include <cstdint>
+
 namespace whirl::matrix::net {
 
 struct Packet {
+  // Receiver does not limit sender
+  static constexpr size_t kUnlimitedWindow = SIZE_MAX;
+
   enum class Type {
     Data,   // User message
     Reset,  // Connection reset by peer
-    Ping    // Keep-alive
+    Ping,   // Keep-alive
+    Ack     // Flow control: data consumed by receiver
   };
 
   struct Header {
@@ -18,10 +24,35 @@ struct Packet {
     Port source_port;
     Port dest_port;
     Timestamp ts;
+
+    // Flow control
+    // Data: sender waits for ack
+    bool need_ack = false;
+    // Ack: number of bytes consumed
+    size_t ack_bytes = 0;
+    // Ack: free space in receive buffer
+    size_t window = kUnlimitedWindow;
+
+    // ECN
+    // Data: congestion experienced, marked by link
+    bool ce = false;
+    // Ack: congestion mark echoed back to sender
+    bool ece = false;
   };
 
   Header header;
   Message message;
 };
 
+// Flow control: `bytes` of data packet consumed (or lost)
+inline Packet MakeAck(const Packet::Header& data, size_t bytes,
+                      size_t window = Packet::kUnlimitedWindow) {
+  Packet::Header header{Packet::Type::Ack, data.dest_port, data.source_port,
+                        data.ts};
+  header.ack_bytes = bytes;
+  header.window = window;
+  header.ece = data.ce;
+  return {header, "<ack>"};
+}
+
 }  // namespace whirl::matrix::net
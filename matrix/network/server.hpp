@@ -14,6 +14,8 @@ struct IServer {
 
   virtual const std::string& HostName() const = 0;
   virtual ZoneId Zone() const = 0;
+  // Rack within zone
+  virtual size_t Rack() const = 0;
 
   virtual void HandlePacket(const Packet& packet, Link* out) = 0;
 };
@@ -5,11 +5,13 @@
 
 #include <matrix/new/new.hpp>
 
+#include <vector>
+
 namespace whirl::matrix::net {
 
 //////////////////////////////////////////////////////////////////////
 
-class ClientSocket::Impl {
+class ClientSocket::Impl : public IWritableListener {
  public:
   Impl(Transport* transport, Link* link, Port self, Port server, Timestamp ts)
       : transport_(transport),
@@ -30,7 +32,35 @@ class ClientSocket::Impl {
 
   void Send(const Message& message) {
     GlobalAllocatorGuard g;
-    link_->Add(MakePacket(message));
+    transport_->Send(self_port_, link_, MakePacket(message));
+  }
+
+  await::futures::Future<void> Writable() {
+    auto [f, p] = await::futures::MakeContract<void>();
+
+    if (transport_->IsWritable(self_port_)) {
+      std::move(p).Set();
+    } else {
+      waiters_.push_back(std::move(p));
+      transport_->NotifyWhenWritable(self_port_, this);
+    }
+
+    return std::move(f);
+  }
+
+  size_t CongestionMarks() const {
+    return transport_->CongestionMarks(self_port_);
+  }
+
+  // IWritableListener
+
+  void OnWritable() override {
+    auto waiters = std::move(waiters_);
+    waiters_.clear();
+
+    for (auto& p : waiters) {
+      std::move(p).Set();
+    }
   }
 
  private:
@@ -48,6 +78,8 @@ class ClientSocket::Impl {
   Port self_port_;
   Port server_port_;
   Timestamp ts_;
+
+  std::vector<await::futures::Promise<void>> waiters_;
 };
 
 ClientSocket::ClientSocket(Transport* transport, Link* link, Port self,
@@ -66,6 +98,14 @@ void ClientSocket::Send(const Message& message) {
   impl_->Send(message);
 }
 
+await::futures::Future<void> ClientSocket::Writable() {
+  return impl_->Writable();
+}
+
+size_t ClientSocket::CongestionMarks() const {
+  return impl_->CongestionMarks();
+}
+
 void ClientSocket::Close() {
   impl_.reset();
 }
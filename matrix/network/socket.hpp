@@ -5,6 +5,8 @@
 #include <matrix/network/timestamp.hpp>
 #include <matrix/network/packet.hpp>
 
+#include <await/futures/core/future.hpp>
+
 #include <memory>
 
 namespace whirl::matrix::net {
@@ -25,7 +27,19 @@ class ClientSocket {
   const std::string& Peer() const;
 
   bool IsValid() const;
+
+  // Never blocks: with flow control enabled messages that do not fit
+  // into send window are held back by transport
   void Send(const Message& message);
+
+  // Context: Server
+  // Completes when send window has free space
+  await::futures::Future<void> Writable();
+
+  // Context: Server
+  // ECN marks on sent messages echoed back by peer
+  size_t CongestionMarks() const;
+
   void Close();
 
  private:
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdlib>
+
+namespace whirl::matrix::net {
+
+//////////////////////////////////////////////////////////////////////
+
+struct LinkStats {
+  size_t packets = 0;
+  size_t bytes = 0;
+
+  // Transmission queue overflow
+  size_t tail_drops = 0;
+  size_t ecn_marks = 0;
+
+  // Injected faults
+  size_t drops = 0;
+  size_t duplicates = 0;
+  size_t reordered = 0;
+
+  LinkStats& operator+=(const LinkStats& that) {
+    packets += that.packets;
+    bytes += that.bytes;
+    tail_drops += that.tail_drops;
+    ecn_marks += that.ecn_marks;
+    drops += that.drops;
+    duplicates += that.duplicates;
+    reordered += that.reordered;
+    return *this;
+  }
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Flow control, per server
+
+struct TransportStats {
+  // Messages held back by exhausted send window
+  size_t window_stalls = 0;
+  // Peak number of bytes waiting for send window
+  size_t max_send_backlog = 0;
+
+  // Peak number of bytes in receive buffer
+  // Could exceed its capacity: messages are held, not dropped
+  size_t max_recv_backlog = 0;
+
+  // ECN: congestion marks on incoming messages
+  size_t ecn_received = 0;
+  // ECN: marks echoed back to this server as sender
+  size_t ecn_echoes = 0;
+};
+
+}  // namespace whirl::matrix::net
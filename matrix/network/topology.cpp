@@ -0,0 +1,73 @@
+#include <matrix/network/topology.hpp>
+
+#include <matrix/world/global/random.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <algorithm>
+
+namespace whirl::matrix::net {
+
+Topology::Topology() {
+  zones_.push_back("default");
+}
+
+ZoneId Topology::GetZone(const std::string& name) {
+  auto it = std::find(zones_.begin(), zones_.end(), name);
+  if (it != zones_.end()) {
+    return it - zones_.begin();
+  }
+  zones_.push_back(name);
+  return zones_.size() - 1;
+}
+
+const std::string& Topology::ZoneName(ZoneId zone) const {
+  return zones_.at(zone);
+}
+
+void Topology::SetZoneLatency(ZoneId lhs, ZoneId rhs, Jiffies rtt,
+                              Jiffies jitter) {
+  WHEELS_VERIFY(lhs < zones_.size() && rhs < zones_.size(), "Unknown zone");
+  WHEELS_VERIFY(lhs != rhs, "Use SetCrossRackLatency for intra-zone links");
+  zone_latency_[Key(lhs, rhs)] = {rtt, jitter};
+}
+
+void Topology::SetCrossRackLatency(Jiffies rtt, Jiffies jitter) {
+  cross_rack_ = {rtt, jitter};
+}
+
+Jiffies Topology::OneWay(const Latency& latency) {
+  uint64_t delay = latency.rtt.Count() / 2;
+  if (latency.jitter.Count() > 0) {
+    delay += GlobalRandomNumber(latency.jitter.Count() + 1);
+  }
+  return delay;
+}
+
+Jiffies Topology::ExtraFlightTime(const IServer* start,
+                                  const IServer* end) const {
+  if (start->Zone() != end->Zone()) {
+    auto it = zone_latency_.find(Key(start->Zone(), end->Zone()));
+    if (it == zone_latency_.end()) {
+      return 0;
+    }
+    return OneWay(it->second);
+  }
+
+  if (start->Rack() != end->Rack()) {
+    return OneWay(cross_rack_);
+  }
+
+  return 0;
+}
+
+Jiffies Topology::MaxRtt() const {
+  uint64_t max_rtt = cross_rack_.rtt.Count() + 2 * cross_rack_.jitter.Count();
+  for (const auto& [_, latency] : zone_latency_) {
+    max_rtt = std::max(max_rtt,
+                       latency.rtt.Count() + 2 * latency.jitter.Count());
+  }
+  return max_rtt;
+}
+
+}  // namespace whirl::matrix::net
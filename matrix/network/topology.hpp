@@ -0,0 +1,73 @@
+#pragma once
+
+#include <matrix/network/server.hpp>
+#include <matrix/network/zone.hpp>
+
+#include <whirl/node/time/jiffies.hpp>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace whirl::matrix::net {
+
+// Zones (datacenters) and racks
+// Latency between zones / racks is added to the flight time
+// chosen by the time model
+
+class Topology {
+  struct Latency {
+    Jiffies rtt = 0;
+    // Extra one-way delay in [0, jitter]
+    Jiffies jitter = 0;
+  };
+
+ public:
+  static const ZoneId kDefaultZone = 0;
+
+  Topology();
+
+  // Zones
+
+  // Registers zone on first access
+  ZoneId GetZone(const std::string& name);
+  const std::string& ZoneName(ZoneId zone) const;
+
+  size_t ZoneCount() const {
+    return zones_.size();
+  }
+
+  // Symmetric
+  void SetZoneLatency(ZoneId lhs, ZoneId rhs, Jiffies rtt, Jiffies jitter);
+
+  // Racks
+
+  // Between racks in the same zone
+  void SetCrossRackLatency(Jiffies rtt, Jiffies jitter);
+
+  // Flight time
+
+  // One-way delay from `start` to `end` on top of time model
+  // Does not consume randomness for servers in the same rack
+  // or for links without jitter
+  Jiffies ExtraFlightTime(const IServer* start, const IServer* end) const;
+
+  // Upper bound on extra round-trip time
+  Jiffies MaxRtt() const;
+
+ private:
+  static std::pair<ZoneId, ZoneId> Key(ZoneId lhs, ZoneId rhs) {
+    return {std::min(lhs, rhs), std::max(lhs, rhs)};
+  }
+
+  static Jiffies OneWay(const Latency& latency);
+
+ private:
+  std::vector<std::string> zones_;
+  std::map<std::pair<ZoneId, ZoneId>, Latency> zone_latency_;
+
+  Latency cross_rack_;
+};
+
+}  // namespace whirl::matrix::net
@@ -14,31 +14,17 @@
 
 #include <wheels/support/assert.hpp>
 
-namespace whirl::matrix::net {
-
-namespace detail {
-
-template <typename Callback>
-class TransportTask : public process::ITask {
- public:
-  TransportTask(Callback cb) : cb_(std::move(cb)) {
-  }
-
-  void Run() override {
-    cb_();
-    delete this;
-  }
-
- private:
-  Callback cb_;
-};
+#include <algorithm>
+#include <utility>
 
-}  // namespace detail
+namespace whirl::matrix::net {
 
 Transport::Transport(Network& net, const std::string& host,
-                     process::Memory& heap, process::Scheduler& scheduler)
+                     process::Memory& heap, process::Scheduler& scheduler,
+                     TransportOptions options)
     : net_(net),
       host_(host),
+      options_(options),
       heap_(heap),
       scheduler_(scheduler),
       logger_("Transport", GetLogBackend()) {
@@ -88,7 +74,28 @@ void Transport::RemoveEndpoint(Port port) {
   GlobalAllocatorGuard g;
 
   LOG_INFO("Remove endpoint at port {}", port);
-  endpoints_.erase(port);
+
+  auto endpoint_it = endpoints_.find(port);
+  if (endpoint_it == endpoints_.end()) {
+    return;
+  }
+
+  if (endpoint_it->second.writable.scheduled) {
+    // Scheduler refers to the embedded notice
+    auto node = endpoints_.extract(endpoint_it);
+    node.mapped().writable.removed = true;
+    removed_endpoints_.push_back(std::move(node));
+  } else {
+    endpoints_.erase(endpoint_it);
+  }
+}
+
+void Transport::ReleaseRemovedEndpoint(WritableNotice* notice) {
+  GlobalAllocatorGuard g;
+
+  std::erase_if(removed_endpoints_, [notice](const auto& node) {
+    return &node.mapped().writable == notice;
+  });
 }
 
 void Transport::Reset() {
@@ -98,6 +105,11 @@ void Transport::Reset() {
     LOG_INFO("Remove endpoint at port {}", port);
   }
   endpoints_.clear();
+  // Scheduler is reset as well
+  removed_endpoints_.clear();
+
+  // Wiped with server memory
+  spare_deliveries_.clear();
 }
 
 class Replier {
@@ -152,7 +164,8 @@ void Transport::HandlePacket(const Packet& packet, Link* out) {
   if (endpoint_it == endpoints_.end()) {
     // Endpoint not found
 
-    if (packet.header.type != Packet::Type::Reset) {
+    if (packet.header.type != Packet::Type::Reset &&
+        packet.header.type != Packet::Type::Ack) {
       if (packet.header.type == Packet::Type::Data) {
         LOG_WARN("Endpoint {} not found, drop incoming packet from {}", to,
                  from);
@@ -162,7 +175,16 @@ void Transport::HandlePacket(const Packet& packet, Link* out) {
     return;
   }
 
-  const auto& endpoint = endpoint_it->second;
+  Port port = endpoint_it->first;
+  auto& endpoint = endpoint_it->second;
+
+  if (packet.header.type == Packet::Type::Ack) {
+    // Acks for previous incarnation of endpoint are ignored
+    if (packet.header.ts == endpoint.ts) {
+      HandleAck(endpoint, packet.header);
+    }
+    return;
+  }
 
   if (packet.header.ts < endpoint.ts) {
     // WHIRL_FMT_LOG("Outdated packet, send <reset> packet to {}", from);
@@ -177,14 +199,14 @@ void Transport::HandlePacket(const Packet& packet, Link* out) {
 
   } else if (packet.header.type == Packet::Type::Reset) {
     // Disconnect
-    auto g = heap_.Use();
-
-    auto callback = [handler = endpoint.handler, host = from.host]() {
-      handler->HandleDisconnect(host);
-    };
+    Delivery* delivery = AcquireDelivery(port, endpoint.ts);
+    delivery->handler = endpoint.handler;
+    {
+      auto g = heap_.Use();
+      delivery->peer = from.host;
+    }
 
-    auto task = new detail::TransportTask(std::move(callback));
-    scheduler_.ScheduleAsap(task);
+    scheduler_.ScheduleAsap(&DeliverDisconnect, delivery);
 
     return;
 
@@ -193,16 +215,22 @@ void Transport::HandlePacket(const Packet& packet, Link* out) {
 
     LOG_INFO("Handle message from {}: {}", from, log::FormatMessage(packet.message));
 
-    auto g = heap_.Use();
-
-    auto callback = [handler = endpoint.handler, message = packet.message,
-                     reply_socket = ReplySocket(packet.header, out)]() {
-      handler->HandleMessage(message, reply_socket);
-    };
+    if (options_.recv_buffer > 0) {
+      Enqueue(port, endpoint, packet, out);
+      return;
+    }
 
-    auto* task = new detail::TransportTask(std::move(callback));
+    Delivery* delivery = AcquireDelivery(port, endpoint.ts);
+    delivery->handler = endpoint.handler;
+    delivery->header = packet.header;
+    delivery->out = out;
+    {
+      // Reuses capacity of recycled record
+      auto g = heap_.Use();
+      delivery->message = packet.message;
+    }
 
-    scheduler_.ScheduleAsap(task);
+    scheduler_.ScheduleAsap(&Deliver, delivery);
 
     //    endpoint.handler->HandleMessage(packet.message,
     //                                    ReplySocket(packet.header, out));
@@ -210,6 +238,293 @@ void Transport::HandlePacket(const Packet& packet, Link* out) {
   }
 }
 
+// Send window
+
+void Transport::Send(Port port, Link* link, Packet packet) {
+  GlobalAllocatorGuard g;
+
+  auto endpoint_it = endpoints_.find(port);
+
+  if (endpoint_it == endpoints_.end() ||
+      !HasFlowControl(endpoint_it->second)) {
+    link->Add(std::move(packet));
+    return;
+  }
+
+  auto& endpoint = endpoint_it->second;
+
+  const size_t bytes = packet.message.size();
+  packet.header.need_ack = true;
+
+  if (endpoint.send_queue.empty() && Fits(endpoint, bytes)) {
+    endpoint.in_flight_bytes += bytes;
+    link->Add(std::move(packet));
+    return;
+  }
+
+  // Wait for acks
+  LOG_INFO("Send window at port {} is exhausted, hold message", port);
+
+  endpoint.send_queue.emplace_back(link, std::move(packet));
+  endpoint.send_queue_bytes += bytes;
+
+  ++stats_.window_stalls;
+  stats_.max_send_backlog =
+      std::max(stats_.max_send_backlog, endpoint.send_queue_bytes);
+}
+
+bool Transport::IsWritable(Port port) const {
+  auto endpoint_it = endpoints_.find(port);
+  if (endpoint_it == endpoints_.end()) {
+    return true;
+  }
+  return IsWritable(endpoint_it->second);
+}
+
+bool Transport::HasFlowControl(const Endpoint& endpoint) const {
+  return options_.send_window > 0 ||
+         endpoint.peer_window != Packet::kUnlimitedWindow;
+}
+
+size_t Transport::Window(const Endpoint& endpoint) const {
+  if (options_.send_window == 0) {
+    return endpoint.peer_window;
+  }
+  return std::min(options_.send_window, endpoint.peer_window);
+}
+
+bool Transport::IsWritable(const Endpoint& endpoint) const {
+  if (!HasFlowControl(endpoint)) {
+    return true;
+  }
+  return endpoint.send_queue.empty() &&
+         (endpoint.in_flight_bytes == 0 ||
+          endpoint.in_flight_bytes < Window(endpoint));
+}
+
+void Transport::NotifyWhenWritable(Port port, IWritableListener* listener) {
+  GlobalAllocatorGuard g;
+
+  auto endpoint_it = endpoints_.find(port);
+  WHEELS_VERIFY(endpoint_it != endpoints_.end(), "Endpoint not found");
+  endpoint_it->second.writable_listener = listener;
+}
+
+bool Transport::Fits(const Endpoint& endpoint, size_t bytes) const {
+  // Message larger than window is sent alone,
+  // also probes zero receive window
+  return endpoint.in_flight_bytes == 0 ||
+         endpoint.in_flight_bytes + bytes <= Window(endpoint);
+}
+
+size_t Transport::CongestionMarks(Port port) const {
+  auto endpoint_it = endpoints_.find(port);
+  if (endpoint_it == endpoints_.end()) {
+    return 0;
+  }
+  return endpoint_it->second.congestion_marks;
+}
+
+void Transport::HandleAck(Endpoint& endpoint, const Packet::Header& ack) {
+  if (ack.ece) {
+    ++endpoint.congestion_marks;
+    ++stats_.ecn_echoes;
+  }
+
+  // Every data packet is acked exactly once (duplicates are not acked)
+  WHEELS_VERIFY(ack.ack_bytes <= endpoint.in_flight_bytes,
+                "Ack for more bytes than in flight");
+  endpoint.in_flight_bytes -= ack.ack_bytes;
+
+  if (ack.window != Packet::kUnlimitedWindow) {
+    // Receiver is slow: hold messages until it handles previous ones
+    endpoint.peer_window = ack.window;
+  }
+
+  while (!endpoint.send_queue.empty()) {
+    auto& [link, packet] = endpoint.send_queue.front();
+
+    const size_t next_bytes = packet.message.size();
+    if (!Fits(endpoint, next_bytes)) {
+      break;
+    }
+
+    endpoint.in_flight_bytes += next_bytes;
+    endpoint.send_queue_bytes -= next_bytes;
+
+    link->Add(std::move(packet));
+    endpoint.send_queue.pop_front();
+  }
+
+  if (endpoint.writable_listener != nullptr && IsWritable(endpoint) &&
+      !endpoint.writable.scheduled) {
+    WritableNotice& notice = endpoint.writable;
+    notice.listener = std::exchange(endpoint.writable_listener, nullptr);
+    notice.transport = this;
+    notice.scheduled = true;
+
+    scheduler_.ScheduleAsap(&NotifyWritable, &notice);
+  }
+}
+
+// Receive buffer
+
+void Transport::Enqueue(Port port, Endpoint& endpoint, const Packet& packet,
+                        Link* out) {
+  const size_t bytes = packet.message.size();
+
+  // Over capacity: held anyway, sender is throttled by receive window
+  endpoint.inbox.push_back({packet.header, packet.message, out});
+  endpoint.inbox_bytes += bytes;
+
+  if (endpoint.inbox_bytes > options_.recv_buffer) {
+    LOG_INFO("Receive buffer at port {} is full, hold message", port);
+
+    if (!packet.header.need_ack) {
+      // Sender does not track its messages yet:
+      // advertise zero window, following messages will be acked
+      Packet advert = MakeAck(packet.header, 0, FreeSpace(endpoint));
+      advert.header.ece = false;
+      out->Add(std::move(advert));
+    }
+  }
+
+  stats_.max_recv_backlog =
+      std::max(stats_.max_recv_backlog, endpoint.inbox_bytes);
+
+  // One receive task per endpoint
+  if (!endpoint.receiving) {
+    endpoint.receiving = true;
+    ScheduleReceive(port, endpoint.ts);
+  }
+}
+
+size_t Transport::FreeSpace(const Endpoint& endpoint) const {
+  if (endpoint.inbox_bytes >= options_.recv_buffer) {
+    return 0;
+  }
+  return options_.recv_buffer - endpoint.inbox_bytes;
+}
+
+void Transport::ScheduleReceive(Port port, Timestamp ts) {
+  scheduler_.ScheduleAsap(&Receive, AcquireDelivery(port, ts));
+}
+
+void Transport::ReceiveNext(Delivery* delivery) {
+  auto endpoint_it = endpoints_.find(delivery->port);
+  if (endpoint_it == endpoints_.end() ||
+      endpoint_it->second.ts != delivery->ts) {
+    ReleaseDelivery(delivery);
+    return;  // Endpoint closed
+  }
+
+  auto& endpoint = endpoint_it->second;
+
+  // Copy to server memory
+  const Incoming& next = endpoint.inbox.front();
+  delivery->handler = endpoint.handler;
+  delivery->header = next.header;
+  delivery->message = next.message;
+  delivery->out = next.out;
+
+  {
+    GlobalAllocatorGuard g;
+
+    endpoint.inbox_bytes -= delivery->message.size();
+    endpoint.inbox.pop_front();
+
+    // Ack is sent on handling: sender window is released
+    // only as fast as this server consumes messages
+    delivery->window = FreeSpace(endpoint);
+
+    if (endpoint.inbox.empty()) {
+      endpoint.receiving = false;
+    } else {
+      ScheduleReceive(delivery->port, delivery->ts);
+    }
+  }
+
+  Deliver(delivery);
+}
+
+Transport::Delivery* Transport::AcquireDelivery(Port port, Timestamp ts) {
+  Delivery* delivery;
+
+  if (spare_deliveries_.empty()) {
+    auto g = heap_.Use();
+    delivery = new Delivery{};
+  } else {
+    delivery = spare_deliveries_.back();
+    spare_deliveries_.pop_back();
+  }
+
+  delivery->transport = this;
+  delivery->port = port;
+  delivery->ts = ts;
+  delivery->window = Packet::kUnlimitedWindow;
+
+  return delivery;
+}
+
+void Transport::ReleaseDelivery(Delivery* delivery) {
+  GlobalAllocatorGuard g;
+  spare_deliveries_.push_back(delivery);
+}
+
+void Transport::Deliver(void* ctx) {
+  Delivery* delivery = static_cast<Delivery*>(ctx);
+  Transport* self = delivery->transport;
+
+  self->MaybeSendAck(delivery->header, delivery->message.size(),
+                     delivery->window, delivery->out);
+
+  delivery->handler->HandleMessage(
+      delivery->message, ReplySocket(delivery->header, delivery->out));
+
+  self->ReleaseDelivery(delivery);
+}
+
+void Transport::DeliverDisconnect(void* ctx) {
+  Delivery* delivery = static_cast<Delivery*>(ctx);
+
+  delivery->handler->HandleDisconnect(delivery->peer);
+
+  delivery->transport->ReleaseDelivery(delivery);
+}
+
+void Transport::NotifyWritable(void* ctx) {
+  WritableNotice* notice = static_cast<WritableNotice*>(ctx);
+  notice->scheduled = false;
+
+  if (notice->removed) {
+    // Socket was closed before notice ran
+    notice->transport->ReleaseRemovedEndpoint(notice);
+    return;
+  }
+
+  notice->listener->OnWritable();
+}
+
+void Transport::Receive(void* ctx) {
+  Delivery* delivery = static_cast<Delivery*>(ctx);
+  delivery->transport->ReceiveNext(delivery);
+}
+
+void Transport::MaybeSendAck(const Packet::Header& data, size_t bytes,
+                             size_t window, Link* out) {
+  if (!data.need_ack && !data.ce) {
+    return;
+  }
+
+  if (data.ce) {
+    ++stats_.ecn_received;
+  }
+
+  GlobalAllocatorGuard g;
+  // Without flow control only the congestion mark is echoed
+  out->Add(MakeAck(data, data.need_ack ? bytes : 0, window));
+}
+
 Port Transport::FindFreePort() {
   while (true) {
     if (endpoints_.count(next_port_) == 0) {
@@ -4,13 +4,16 @@
 #include <matrix/network/packet.hpp>
 #include <matrix/network/timestamp.hpp>
 #include <matrix/network/socket.hpp>
+#include <matrix/network/stats.hpp>
 
 #include <matrix/process/memory.hpp>
 #include <matrix/process/scheduler.hpp>
 
 #include <timber/logger.hpp>
 
+#include <deque>
 #include <map>
+#include <vector>
 
 namespace whirl::matrix::net {
 
@@ -31,11 +34,83 @@ struct ISocketHandler {
 
 //////////////////////////////////////////////////////////////////////
 
+// Context: Server
+struct IWritableListener {
+  virtual ~IWritableListener() = default;
+
+  // Send window has free space
+  virtual void OnWritable() = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Flow control, 0 - unlimited
+
+struct TransportOptions {
+  // Max number of unacknowledged bytes per client socket
+  size_t send_window = 0;
+  // Received but not yet handled bytes per endpoint
+  // Free space is advertised to senders in acks (receive window),
+  // messages over capacity are held: senders are slowed down
+  size_t recv_buffer = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
 // ~ TCP, Per-server
 class Transport {
+  struct Incoming {
+    Packet::Header header;
+    Message message;
+    Link* out;
+  };
+
+  // Scheduler hook for incoming message or disconnect
+  // Recycled, lives in server memory
+  struct Delivery {
+    Transport* transport;
+    Port port;
+    Timestamp ts;
+
+    ISocketHandler* handler;
+    Packet::Header header;
+    Message message;
+    Link* out;
+    // Receive window advertised in ack
+    size_t window;
+
+    // Disconnect
+    std::string peer;
+  };
+
+  // Scheduler hook for writable notification, embedded in endpoint
+  struct WritableNotice {
+    IWritableListener* listener = nullptr;
+    bool scheduled = false;
+    // Endpoint was removed while notice was scheduled
+    bool removed = false;
+    Transport* transport = nullptr;
+  };
+
   struct Endpoint {
     ISocketHandler* handler;
     Timestamp ts;
+
+    // Send window
+    size_t in_flight_bytes = 0;
+    // Receive window advertised by peer
+    size_t peer_window = Packet::kUnlimitedWindow;
+    // ECN marks echoed by receiver
+    size_t congestion_marks = 0;
+    std::deque<std::pair<Link*, Packet>> send_queue;
+    size_t send_queue_bytes = 0;
+    IWritableListener* writable_listener = nullptr;
+    WritableNotice writable;
+
+    // Receive buffer
+    std::deque<Incoming> inbox;
+    size_t inbox_bytes = 0;
+    bool receiving = false;
   };
 
   friend class ClientSocket;
@@ -43,7 +118,7 @@ class Transport {
 
  public:
   Transport(Network& net, const std::string& host, process::Memory& heap,
-            process::Scheduler& scheduler);
+            process::Scheduler& scheduler, TransportOptions options = {});
 
   // Context: Server
   const std::string& HostName() const {
@@ -62,6 +137,11 @@ class Transport {
   // On server crash
   void Reset();
 
+  // Cumulative over server restarts
+  const TransportStats& GetStats() const {
+    return stats_;
+  }
+
  private:
   // Context: Server
   // Invoked from socket destructor
@@ -69,15 +149,68 @@ class Transport {
 
   Port FindFreePort();
 
+  // Send window
+
+  // Context: Server
+  void Send(Port port, Link* link, Packet packet);
+  // Context: Server
+  bool IsWritable(Port port) const;
+  // Context: Server
+  // Listener is notified once
+  void NotifyWhenWritable(Port port, IWritableListener* listener);
+
+  // Context: Server
+  size_t CongestionMarks(Port port) const;
+
+  // Own send window or receive window of peer
+  bool HasFlowControl(const Endpoint& endpoint) const;
+  size_t Window(const Endpoint& endpoint) const;
+  bool IsWritable(const Endpoint& endpoint) const;
+  bool Fits(const Endpoint& endpoint, size_t bytes) const;
+  void HandleAck(Endpoint& endpoint, const Packet::Header& ack);
+
+  // Receive buffer
+
+  void Enqueue(Port port, Endpoint& endpoint, const Packet& packet, Link* out);
+  size_t FreeSpace(const Endpoint& endpoint) const;
+  void ScheduleReceive(Port port, Timestamp ts);
+  // Context: Server
+  void ReceiveNext(Delivery* delivery);
+
+  // Incoming messages
+
+  Delivery* AcquireDelivery(Port port, Timestamp ts);
+  void ReleaseDelivery(Delivery* delivery);
+
+  // Scheduler routines, context: Server
+  static void Deliver(void* delivery);
+  static void Receive(void* delivery);
+  static void DeliverDisconnect(void* delivery);
+  static void NotifyWritable(void* notice);
+
+  void ReleaseRemovedEndpoint(WritableNotice* notice);
+
+  // Acks consumed bytes and / or echoes congestion mark
+  void MaybeSendAck(const Packet::Header& data, size_t bytes, size_t window,
+                    Link* out);
+
  private:
   Network& net_;
   std::string host_;
 
   // Local endpoints
   std::map<Port, Endpoint> endpoints_;
+  // Removed, but writable notice is still scheduled
+  // Node handles keep notices in place
+  std::vector<std::map<Port, Endpoint>::node_type> removed_endpoints_;
 
   Port next_port_{1};
 
+  TransportOptions options_;
+  TransportStats stats_;
+
+  std::vector<Delivery*> spare_deliveries_;
+
   // To invoke ISocketHandler methods
   process::Memory& heap_;
   process::Scheduler& scheduler_;
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <matrix/time/time_point.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace whirl::matrix::process {
+
+////////////////////////////////////////////////////////////////////////
+
+struct CpuStats {
+  size_t tasks = 0;
+  // Total CPU time charged
+  uint64_t busy_time = 0;
+  // Time tasks spent in run queue waiting for free core
+  uint64_t total_queue_delay = 0;
+  uint64_t max_queue_delay = 0;
+};
+
+////////////////////////////////////////////////////////////////////////
+
+// Simulated CPU
+// Each task occupies one core for the CPU time charged while it runs
+// Time inside the task advances with the charged CPU time (see GlobalNow):
+// messages sent, timers set and clocks read after charging `cost`
+// happen `cost` later than task start
+// 0 cores - unlimited, tasks take zero time
+
+class Cpu {
+ public:
+  explicit Cpu(size_t cores) : free_at_(cores, 0) {
+  }
+
+  bool IsUnlimited() const {
+    return free_at_.empty();
+  }
+
+  // Earliest time when some core is free
+  TimePoint NextFreeTime() const {
+    if (IsUnlimited()) {
+      return 0;
+    }
+    return *std::min_element(free_at_.begin(), free_at_.end());
+  }
+
+  // `scheduled` - time task became runnable
+  void StartTask(TimePoint now, TimePoint scheduled) {
+    WHEELS_VERIFY(!running_, "Task already running");
+
+    running_ = true;
+    charged_ = 0;
+    start_ = now;
+
+    ++stats_.tasks;
+    if (now > scheduled) {
+      const uint64_t delay = now - scheduled;
+      stats_.total_queue_delay += delay;
+      stats_.max_queue_delay = std::max(stats_.max_queue_delay, delay);
+    }
+  }
+
+  // Context: running task
+  void Charge(uint64_t cost) {
+    WHEELS_VERIFY(running_, "No running task");
+    charged_ += cost;
+  }
+
+  // CPU time charged to running task so far
+  uint64_t Elapsed() const {
+    if (!running_ || IsUnlimited()) {
+      return 0;
+    }
+    return charged_;
+  }
+
+  void FinishTask() {
+    if (!running_) {
+      return;  // Server crashed by running task
+    }
+    running_ = false;
+
+    stats_.busy_time += charged_;
+
+    if (IsUnlimited()) {
+      return;
+    }
+
+    // Occupy the earliest available core
+    auto core = std::min_element(free_at_.begin(), free_at_.end());
+    *core = std::max(*core, start_) + charged_;
+  }
+
+  // On server crash
+  void Reset() {
+    std::fill(free_at_.begin(), free_at_.end(), 0);
+    running_ = false;
+  }
+
+  // Cumulative over server restarts
+  const CpuStats& GetStats() const {
+    return stats_;
+  }
+
+ private:
+  std::vector<TimePoint> free_at_;
+
+  bool running_{false};
+  TimePoint start_{0};
+  uint64_t charged_{0};
+
+  CpuStats stats_;
+};
+
+}  // namespace whirl::matrix::process
@@ -0,0 +1,53 @@
+#include <matrix/process/scheduler.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace whirl::matrix::process {
+
+////////////////////////////////////////////////////////////////////////
+
+Scheduler::ScheduledTask Scheduler::TakeNextImpl() {
+  if (NextIsOverdue()) {
+    ScheduledTask next = overdue_.front();
+    overdue_.pop_front();
+    return next;
+  }
+  return queue_.Extract();
+}
+
+void Scheduler::Resume(TimePoint at) {
+  GlobalAllocatorGuard g;
+
+  paused_ = false;
+
+  // Same order as reinsertion at `at` with fresh seq numbers
+
+  std::deque<ScheduledTask> postponed;
+  while (!IsEmpty() && NextTaskTime() < at) {
+    ScheduledTask next = TakeNextImpl();
+    next.at_time = at;
+    next.seq = next_seq_++;
+    postponed.push_back(next);
+  }
+
+  if (postponed.empty()) {
+    return;
+  }
+
+  if (overdue_.empty()) {
+    overdue_.swap(postponed);
+    return;
+  }
+
+  // Rare: tasks postponed by previous `Resume` are not overdue yet
+  std::deque<ScheduledTask> merged;
+  std::merge(overdue_.begin(), overdue_.end(), postponed.begin(),
+             postponed.end(), std::back_inserter(merged),
+             [](const ScheduledTask& lhs, const ScheduledTask& rhs) {
+               return lhs.Before(rhs);
+             });
+  overdue_.swap(merged);
+}
+
+}  // namespace whirl::matrix::process
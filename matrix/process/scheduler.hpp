@@ -8,14 +8,18 @@
 
 #include <matrix/world/global/time.hpp>
 
+#include <wheels/support/assert.hpp>
+
+#include <deque>
+
 namespace whirl::matrix::process {
 
 ////////////////////////////////////////////////////////////////////////
 
-struct ITask {
-  virtual ~ITask() = default;
-  virtual void Run() = 0;
-};
+// Intrusive tasks: `ctx` is an object that is already allocated
+// (user task, message record, timer, server), so scheduling
+// does not allocate
+using TaskRoutine = void (*)(void* ctx);
 
 ////////////////////////////////////////////////////////////////////////
 
@@ -23,98 +27,99 @@ class Scheduler {
  public:
   struct ScheduledTask {
     TimePoint at_time;
-    ITask* task;
+    TaskRoutine routine;
+    void* ctx;
+    // Ties are broken by scheduling order
+    uint64_t seq = 0;
 
     bool operator<(const ScheduledTask& that) const {
       return at_time < that.at_time;
     }
 
+    bool Before(const ScheduledTask& that) const {
+      return at_time < that.at_time ||
+             (at_time == that.at_time && seq < that.seq);
+    }
+
     void operator()() {
-      task->Run();
+      routine(ctx);
     }
   };
 
  public:
   Scheduler() = default;
 
-  void Schedule(TimePoint at, ITask* task) {
+  void Schedule(TimePoint at, TaskRoutine routine, void* ctx) {
     GlobalAllocatorGuard g;
-    ScheduleImpl(at, task);
+    ScheduleImpl({at, routine, ctx});
   }
 
-  void ScheduleAsap(ITask* task) {
+  void ScheduleAsap(TaskRoutine routine, void* ctx) {
     GlobalAllocatorGuard g;
     auto asap = GlobalNow();
-    ScheduleImpl(asap, task);
+    ScheduleImpl({asap, routine, ctx});
   }
 
   bool IsEmpty() const {
-    return queue_.IsEmpty();
+    return queue_.IsEmpty() && overdue_.empty();
   }
 
   size_t QueueSize() const {
-    return queue_.Size();
+    return queue_.Size() + overdue_.size();
   }
 
   TimePoint NextTaskTime() const {
-    return queue_.Smallest().at_time;
+    return NextIsOverdue() ? overdue_.front().at_time
+                           : queue_.Smallest().at_time;
   }
 
-  ITask* TakeNext() {
-    return queue_.Extract().task;
+  ScheduledTask TakeNext() {
+    WHEELS_VERIFY(!paused_, "Scheduler is paused");
+    return TakeNextImpl();
   }
 
   void Reset() {
     queue_.Clear();
+    overdue_.clear();
+    paused_ = false;
   }
 
-  void Pause() {
-    // Do nothing
+  bool IsPaused() const {
+    return paused_;
   }
 
-  void Resume(TimePoint at) {
-    while (!queue_.IsEmpty() && queue_.Smallest().at_time < at) {
-      auto next = queue_.Extract();
-      queue_.Insert({at, next.task});
-    }
+  void Pause() {
+    paused_ = true;
   }
 
- private:
-  void ScheduleImpl(TimePoint at, ITask* task) {
-    queue_.Insert({at, task});
-  }
+  // Tasks due before `at` are postponed to `at`, after tasks
+  // already scheduled at `at`, in their original order
+  // O(k log n) for k overdue tasks
+  void Resume(TimePoint at);
 
  private:
-  PriorityQueue<ScheduledTask> queue_;
-};
-
-////////////////////////////////////////////////////////////////////////
-
-// From user space
-
-namespace detail {
-
-template <typename F>
-class AutomaticStorageTask : public ITask {
- public:
-  AutomaticStorageTask(F&& f) : f_(std::move(f)) {
+  void ScheduleImpl(ScheduledTask task) {
+    task.seq = next_seq_++;
+    queue_.Insert(task);
   }
 
-  void Run() override {
-    f_();
-    delete this;
+  bool NextIsOverdue() const {
+    if (overdue_.empty()) {
+      return false;
+    }
+    return queue_.IsEmpty() || overdue_.front().Before(queue_.Smallest());
   }
 
- private:
-  F f_;
-};
+  ScheduledTask TakeNextImpl();
 
-}  // namespace detail
+ private:
+  PriorityQueue<ScheduledTask> queue_;
+  // Postponed by `Resume`, ordered by (at_time, seq)
+  // Kept outside of `queue_` to avoid reinsertion
+  std::deque<ScheduledTask> overdue_;
+  uint64_t next_seq_{0};
 
-template <typename F>
-void Schedule(Scheduler& scheduler, TimePoint t, F&& f) {
-  ITask* task = new detail::AutomaticStorageTask(std::move(f));
-  scheduler.Schedule(t, task);
-}
+  bool paused_{false};
+};
 
 }  // namespace whirl::matrix::process
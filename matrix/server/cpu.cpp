@@ -0,0 +1,11 @@
+#include <matrix/server/cpu.hpp>
+
+#include <matrix/server/server.hpp>
+
+namespace whirl::matrix {
+
+void ChargeCpu(Jiffies cost) {
+  ThisServer().ChargeCpu(cost);
+}
+
+}  // namespace whirl::matrix
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <whirl/node/time/jiffies.hpp>
+
+namespace whirl::matrix {
+
+// Context: Server task
+// Current task occupies CPU core for `cost` more virtual time,
+// see ServerOptions::cpu_cores
+void ChargeCpu(Jiffies cost);
+
+}  // namespace whirl::matrix
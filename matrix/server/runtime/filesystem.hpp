@@ -69,6 +69,14 @@ class FS : public persist::fs::IFileSystem {
     return impl_->Read(fd, buffer);
   }
 
+  // Matrix extension (~ pread), used by database
+  // Only for FileMode::Read
+  wheels::Result<size_t> PRead(persist::fs::Fd fd, size_t offset,
+                               wheels::MutableMemView buffer) {
+    disk_.Read(buffer.Size());  // Blocks
+    return impl_->PRead(fd, offset, buffer);
+  }
+
   wheels::Status Sync(persist::fs::Fd fd) override {
     return impl_->Sync(fd);
   }
@@ -44,6 +44,18 @@ class NetTransportSocket : public transport::ISocket,
     socket_.Close();
   }
 
+  // Backpressure: await before `Send` to block sending fiber
+  // while send window is exhausted
+  await::futures::Future<void> Writable() {
+    return socket_.Writable();
+  }
+
+  // ECN: congestion marks echoed by peer, grows while
+  // transmission queues on the path are over capacity
+  size_t CongestionMarks() const {
+    return socket_.IsValid() ? socket_.CongestionMarks() : 0;
+  }
+
   // INetSocketHandler
 
   void HandleMessage(const std::string& message,
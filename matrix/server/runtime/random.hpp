@@ -9,6 +9,10 @@
 
 namespace whirl::matrix {
 
+// NB: IRandomService (whirl-frontend) does not pass the call site,
+// so all node::rt::RandomNumber draws share this site in decision log.
+// Matrix code should call GlobalRandomNumber directly
+
 struct RandomGenerator : node::random::IRandomService {
   uint64_t GenerateNumber(uint64_t bound) override {
     WHEELS_ASSERT(bound > 0, "bound == 0");
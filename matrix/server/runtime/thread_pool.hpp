@@ -31,7 +31,8 @@ class ThreadPool {
   }
 
   void Submit(await::executors::TaskBase* user_task) {
-    scheduler_.Schedule(ScheduleTask(), ConvertTask(user_task));
+    // User task is scheduled as is, without wrapper
+    scheduler_.Schedule(ScheduleTask(), &RunUserTask, user_task);
   }
 
   await::executors::IExecutor* GetExecutor() {
@@ -39,26 +40,16 @@ class ThreadPool {
   }
 
  private:
+  // Local time of submitting task, i.e. after CPU time charged so far
+  // Execution delay and cost are modelled by server CPU:
+  // run queue waits for free core, task is charged
+  // IServerTimeModel::TaskCpuTime
   TimePoint ScheduleTask() const {
-    return GlobalNow();  // TODO: ITimeModel?
+    return GlobalNow();
   }
 
-  class TaskAdapter : public process::ITask {
-   public:
-    TaskAdapter(await::executors::TaskBase* impl) : impl_(impl) {
-    }
-
-    void Run() override {
-      impl_->Run();
-      delete this;
-    }
-
-   private:
-    await::executors::TaskBase* impl_;
-  };
-
-  process::ITask* ConvertTask(await::executors::TaskBase* user_task) {
-    return new TaskAdapter(user_task);
+  static void RunUserTask(void* user_task) {
+    static_cast<await::executors::TaskBase*>(user_task)->Run();
   }
 
  private:
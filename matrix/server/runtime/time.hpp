@@ -8,6 +8,9 @@
 
 #include <await/futures/core/future.hpp>
 
+#include <optional>
+#include <vector>
+
 namespace whirl::matrix {
 
 //////////////////////////////////////////////////////////////////////
@@ -15,6 +18,12 @@ namespace whirl::matrix {
 // Time service impl
 
 class TimeService : public node::time::ITimeService {
+  // Recycled, lives in node memory
+  struct Timer {
+    TimeService* service;
+    std::optional<await::futures::Promise<void>> promise;
+  };
+
  public:
   TimeService(clocks::WallClock& wall_clock,
               clocks::MonotonicClock& monotonic_clock,
@@ -38,14 +47,34 @@ class TimeService : public node::time::ITimeService {
 
     auto [f, p] = await::futures::MakeContract<void>();
 
-    auto cb = [timer_promise = std::move(p)]() mutable {
-      std::move(timer_promise).Set();
-    };
-    Schedule(scheduler_, after, std::move(cb));
+    Timer* timer = AcquireTimer();
+    timer->promise.emplace(std::move(p));
+    scheduler_.Schedule(after, &Fire, timer);
+
     return std::move(f);
   }
 
  private:
+  Timer* AcquireTimer() {
+    if (spare_timers_.empty()) {
+      return new Timer{this, std::nullopt};
+    }
+    Timer* timer = spare_timers_.back();
+    spare_timers_.pop_back();
+    return timer;
+  }
+
+  static void Fire(void* ctx) {
+    Timer* timer = static_cast<Timer*>(ctx);
+
+    auto promise = std::move(*timer->promise);
+    timer->promise.reset();
+    // Before `Set`: continuation could start new timer
+    timer->service->spare_timers_.push_back(timer);
+
+    std::move(promise).Set();
+  }
+
   Jiffies ToRealTimeDelay(Jiffies delay) const {
     return monotonic_clock_.SleepOrTimeout(delay);
   }
@@ -59,6 +88,8 @@ class TimeService : public node::time::ITimeService {
   clocks::MonotonicClock& monotonic_clock_;
 
   process::Scheduler& scheduler_;
+
+  std::vector<Timer*> spare_timers_;
 };
 
 }  // namespace whirl::matrix
@@ -1,6 +1,7 @@
 #include <matrix/server/server.hpp>
 
 #include <matrix/world/global/actor.hpp>
+#include <matrix/world/global/coverage.hpp>
 #include <matrix/world/global/log.hpp>
 #include <matrix/world/global/scope.hpp>
 
@@ -12,6 +13,8 @@
 
 #include <timber/log.hpp>
 
+#include <algorithm>
+
 namespace whirl::matrix {
 
 //////////////////////////////////////////////////////////////////////
@@ -20,7 +23,10 @@ Server::Server(net::Network& net, ServerConfig config,
                node::program::Main program)
     : config_(config),
       program_(program),
-      transport_(net, config.hostname, heap_, scheduler_),
+      cpu_(config.options.cpu_cores),
+      transport_(net, config.hostname, heap_, scheduler_,
+                 {config.options.net_send_window,
+                  config.options.net_recv_buffer}),
       logger_("Server", GetLogBackend()) {
 }
 
@@ -43,6 +49,11 @@ bool Server::IsAlive() const {
 }
 
 void Server::Crash() {
+  Cover("fault:crash");
+  DoCrash();
+}
+
+void Server::DoCrash() {
 #if __has_feature(address_sanitizer)
   WHEELS_PANIC("Crashes are incompatible with Address Sanitizer");
 #endif
@@ -61,6 +72,8 @@ void Server::Crash() {
   filesystem_.Reset();
   // Drop scheduled tasks
   scheduler_.Reset();
+  // Free CPU cores
+  cpu_.Reset();
   // 2) Clean memory
   heap_.Reset();
 
@@ -69,6 +82,8 @@ void Server::Crash() {
   // Clear stdout?
 
   state_ = State::Crashed;
+
+  InvalidateActor(this);
 }
 
 void Server::FastReboot() {
@@ -78,8 +93,10 @@ void Server::FastReboot() {
     return;
   }
 
-  Crash();
-  Launch();
+  Cover("fault:reboot");
+
+  DoCrash();
+  DoLaunch();
 }
 
 void Server::Pause() {
@@ -93,8 +110,13 @@ void Server::Pause() {
     return;
   }
 
+  Cover("fault:pause");
+
   //WHEELS_VERIFY(state_ != State::Paused, "Server already paused");
+  scheduler_.Pause();
   state_ = State::Paused;
+
+  InvalidateActor(this);
 }
 
 void Server::Resume() {
@@ -104,6 +126,8 @@ void Server::Resume() {
     return;
   }
 
+  Cover("fault:resume");
+
   auto actor_scope = SwitchToActor(this);
 
   WHEELS_VERIFY(state_ == State::Paused, "Server is not paused");
@@ -111,9 +135,13 @@ void Server::Resume() {
   scheduler_.Resume(GlobalNow());
 
   state_ = State::Running;
+
+  InvalidateActor(this);
 }
 
 void Server::AdjustWallClock() {
+  Cover("fault:adjust_clock");
+
   LOG_INFO("Adjust wall time clock on {}", HostName());
 
   GlobalAllocatorGuard g;
@@ -139,6 +167,7 @@ persist::fs::FileList Server::ListFiles(std::string_view prefix) {
 
 void Server::CorruptFile(const persist::fs::Path& file_path) {
   GlobalAllocatorGuard g;
+  Cover("fault:corrupt_file");
   filesystem_.Corrupt(file_path);
 }
 
@@ -154,10 +183,15 @@ void Server::Start() {
   wall_clock_.Init();
   monotonic_clock_.Init();
 
-  Launch();
+  DoLaunch();
 }
 
 void Server::Launch() {
+  Cover("fault:launch");
+  DoLaunch();
+}
+
+void Server::DoLaunch() {
   WHEELS_VERIFY(state_ == State::Initial || state_ == State::Crashed,
                 "Invalid state");
 
@@ -169,6 +203,8 @@ void Server::Launch() {
   StartProcess();
 
   state_ = State::Running;
+
+  InvalidateActor(this);
 }
 
 void Server::StartProcess() {
@@ -178,9 +214,11 @@ void Server::StartProcess() {
   runtime_ = MakeNodeRuntime();
 
   // Run user program
-  process::Schedule(scheduler_, GlobalNow(), [this]() {
-    process::MainTrampoline(program_);
-  });
+  scheduler_.Schedule(GlobalNow(), &RunMain, this);
+}
+
+void Server::RunMain(void* server) {
+  process::MainTrampoline(static_cast<Server*>(server)->program_);
 }
 
 bool Server::IsRunnable() const {
@@ -191,26 +229,35 @@ bool Server::IsRunnable() const {
 }
 
 TimePoint Server::NextStepTime() const {
-  return scheduler_.NextTaskTime();
+  // Run queue: wait for free core
+  return std::max(scheduler_.NextTaskTime(), cpu_.NextFreeTime());
 }
 
 void Server::Step() {
-  process::ITask* task = scheduler_.TakeNext();
+  auto task = scheduler_.TakeNext();
+
+  cpu_.StartTask(GlobalNow(), task.at_time);
+  if (!cpu_.IsUnlimited()) {
+    cpu_.Charge(time_model_->TaskCpuTime().Count());
+  }
+
   {
     auto g = heap_.Use();
-    task->Run();
+    task();
   }
+
+  cpu_.FinishTask();
 }
 
 void Server::Shutdown() {
   if (state_ != State::Crashed) {
-    Crash();
+    DoCrash();
   }
 }
 
-size_t Server::ComputeDigest() const {
+Digest128 Server::ComputeDigest() const {
   if (state_ == State::Crashed) {
-    return 0;
+    return {};
   }
 
   DigestCalculator digest;
@@ -218,7 +265,7 @@ size_t Server::ComputeDigest() const {
   digest.Eat(heap_.BytesAllocated());
   // Fs
   digest.Combine(filesystem_.ComputeDigest());
-  return digest.GetValue();
+  return digest.GetDigest();
 }
 
 // Private
@@ -233,7 +280,10 @@ node::IRuntime* Server::MakeNodeRuntime() {
 
   runtime->fs.Init(&filesystem_, runtime->time.Get());
 
-  runtime->db.Init(runtime->fs.Get());
+  db::Options db_options;
+  db_options.block_cache_bytes = config_.options.db_block_cache;
+  db_options.mem_table = config_.options.db_mem_table;
+  runtime->db.Init(runtime->fs.Get(), db_options, &db_stats_);
 
   runtime->transport.Init(transport_);
 
@@ -16,10 +16,15 @@
 
 #include <matrix/fs/fs.hpp>
 
+#include <matrix/helpers/digest.hpp>
+
+#include <matrix/db/stats.hpp>
+
 #include <matrix/network/server.hpp>
 #include <matrix/network/network.hpp>
 #include <matrix/network/transport.hpp>
 
+#include <matrix/process/cpu.hpp>
 #include <matrix/process/memory.hpp>
 #include <matrix/process/scheduler.hpp>
 
@@ -54,7 +59,11 @@ class Server : public IActor, public fault::IFaultyServer, public net::IServer {
   }
 
   net::ZoneId Zone() const override {
-    return 0;  // TODO
+    return config_.zone;
+  }
+
+  size_t Rack() const override {
+    return config_.rack;
   }
 
   void HandlePacket(const net::Packet& packet, net::Link* out) override;
@@ -90,6 +99,9 @@ class Server : public IActor, public fault::IFaultyServer, public net::IServer {
   bool IsRunnable() const override;
   TimePoint NextStepTime() const override;
   void Step() override;
+  uint64_t StepElapsed() const override {
+    return cpu_.Elapsed();
+  }
   void Shutdown() override;
 
   // Simulation
@@ -98,15 +110,42 @@ class Server : public IActor, public fault::IFaultyServer, public net::IServer {
     return stdout_.lines;
   }
 
-  size_t ComputeDigest() const;
+  Digest128 ComputeDigest() const;
+
+  size_t HeapBytesAllocated() const {
+    return heap_.BytesAllocated();
+  }
+
+  const db::Stats& GetDbStats() const {
+    return db_stats_;
+  }
+
+  const net::TransportStats& GetTransportStats() const {
+    return transport_.GetStats();
+  }
+
+  const process::CpuStats& GetCpuStats() const {
+    return cpu_.GetStats();
+  }
+
+  // Context: Server task
+  void ChargeCpu(Jiffies cost) {
+    cpu_.Charge(cost.Count());
+  }
 
   node::IRuntime& GetNodeRuntime();
 
   IServerTimeModel* GetTimeModel();
 
  private:
+  // Crash / Launch without coverage point: used by Start / Shutdown
+  void DoCrash();
+  void DoLaunch();
+
   node::IRuntime* MakeNodeRuntime();
   void StartProcess();
+  // Scheduler routine, context: Server
+  static void RunMain(void* server);
 
  private:
   State state_{State::Initial};
@@ -119,6 +158,7 @@ class Server : public IActor, public fault::IFaultyServer, public net::IServer {
   // Hardware
   clocks::WallClock wall_clock_;
   clocks::MonotonicClock monotonic_clock_;
+  process::Cpu cpu_;
 
   // Operating system
   process::Scheduler scheduler_;
@@ -128,6 +168,9 @@ class Server : public IActor, public fault::IFaultyServer, public net::IServer {
 
   Stdout stdout_;
 
+  // Outlives node process
+  db::Stats db_stats_;
+
   // Node process
   node::IRuntime* runtime_{nullptr};
 
@@ -0,0 +1,73 @@
+#include <matrix/test/corpus.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <algorithm>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+const CorpusEntry& Corpus::Pick(std::mt19937_64& random) const {
+  WHEELS_VERIFY(!entries_.empty(), "Empty corpus");
+  return entries_[random() % entries_.size()];
+}
+
+static size_t RandomIndex(std::mt19937_64& random, size_t size) {
+  return random() % size;
+}
+
+// Havoc-style: a few stacked mutations of the decision sequence
+
+CorpusEntry Corpus::Mutate(std::mt19937_64& random) const {
+  CorpusEntry entry = Pick(random);
+  auto& decisions = entry.decisions;
+
+  if (decisions.empty()) {
+    return entry;
+  }
+
+  const size_t mutations = 1 + random() % 4;
+
+  for (size_t i = 0; i < mutations && !decisions.empty(); ++i) {
+    switch (random() % 5) {
+      case 0: {
+        // Flip bit
+        size_t index = RandomIndex(random, decisions.size());
+        decisions[index] ^= uint64_t{1} << (random() % 64);
+        break;
+      }
+      case 1: {
+        // Replace with random value
+        size_t index = RandomIndex(random, decisions.size());
+        decisions[index] = random();
+        break;
+      }
+      case 2: {
+        // Nudge: small "choose index" values are sensitive to low bits
+        size_t index = RandomIndex(random, decisions.size());
+        decisions[index] += (random() % 2 == 0) ? 1 : -1;
+        break;
+      }
+      case 3: {
+        // Truncate: the rest is driven by the world seed
+        decisions.resize(RandomIndex(random, decisions.size()) + 1);
+        break;
+      }
+      case 4: {
+        // Splice with another entry
+        const auto& other = Pick(random).decisions;
+        size_t at = RandomIndex(random, decisions.size());
+        decisions.resize(at);
+        if (at < other.size()) {
+          decisions.insert(decisions.end(), other.begin() + at, other.end());
+        }
+        break;
+      }
+    }
+  }
+
+  return entry;
+}
+
+}  // namespace whirl::matrix
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <matrix/world/random_source.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+// Simulations that discovered new coverage
+// Simulation input = world seed + prefix of random decisions
+
+struct CorpusEntry {
+  size_t seed;
+  RandomDecisions decisions;
+};
+
+class Corpus {
+ public:
+  bool IsEmpty() const {
+    return entries_.empty();
+  }
+
+  size_t Size() const {
+    return entries_.size();
+  }
+
+  void Add(CorpusEntry entry) {
+    entries_.push_back(std::move(entry));
+  }
+
+  // Random entry with mutated decisions
+  CorpusEntry Mutate(std::mt19937_64& random) const;
+
+ private:
+  const CorpusEntry& Pick(std::mt19937_64& random) const;
+
+ private:
+  std::vector<CorpusEntry> entries_;
+};
+
+}  // namespace whirl::matrix
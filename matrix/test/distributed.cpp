@@ -0,0 +1,440 @@
+#include <matrix/test/distributed.hpp>
+
+#include <wheels/support/assert.hpp>
+#include <wheels/support/panic.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+// Sockets
+
+static bool IsTcpAddress(const std::string& address) {
+  return address.find(':') != std::string::npos &&
+         address.find('/') == std::string::npos;
+}
+
+static sockaddr_un MakeUnixAddress(const std::string& path) {
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  WHEELS_VERIFY(path.size() < sizeof(addr.sun_path),
+                "Unix socket path is too long: " << path);
+  std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  return addr;
+}
+
+static addrinfo* ResolveTcp(const std::string& address, bool passive) {
+  auto colon = address.rfind(':');
+  std::string host = address.substr(0, colon);
+  std::string port = address.substr(colon + 1);
+
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = passive ? AI_PASSIVE : 0;
+
+  addrinfo* result = nullptr;
+  int error = ::getaddrinfo(host.empty() ? nullptr : host.c_str(),
+                            port.c_str(), &hints, &result);
+  WHEELS_VERIFY(error == 0, "Failed to resolve " << address << ": "
+                                                 << ::gai_strerror(error));
+  return result;
+}
+
+static int Listen(const std::string& address) {
+  int fd;
+
+  if (IsTcpAddress(address)) {
+    addrinfo* info = ResolveTcp(address, /*passive=*/true);
+    fd = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+    WHEELS_VERIFY(fd >= 0, "Failed to create socket");
+    int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    int bound = ::bind(fd, info->ai_addr, info->ai_addrlen);
+    ::freeaddrinfo(info);
+    WHEELS_VERIFY(bound == 0, "Failed to bind " << address);
+  } else {
+    auto addr = MakeUnixAddress(address);
+    // Stale socket of previous sweep
+    ::unlink(address.c_str());
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    WHEELS_VERIFY(fd >= 0, "Failed to create socket");
+    WHEELS_VERIFY(::bind(fd, (sockaddr*)&addr, sizeof(addr)) == 0,
+                  "Failed to bind " << address);
+  }
+
+  WHEELS_VERIFY(::listen(fd, 128) == 0, "Failed to listen " << address);
+  return fd;
+}
+
+static int TryConnect(const std::string& address) {
+  if (IsTcpAddress(address)) {
+    addrinfo* info = ResolveTcp(address, /*passive=*/false);
+    int fd = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+    int connected = fd >= 0 ? ::connect(fd, info->ai_addr, info->ai_addrlen)
+                            : -1;
+    ::freeaddrinfo(info);
+    if (connected != 0 && fd >= 0) {
+      ::close(fd);
+      return -1;
+    }
+    return fd;
+  } else {
+    auto addr = MakeUnixAddress(address);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && ::connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+      ::close(fd);
+      return -1;
+    }
+    return fd;
+  }
+}
+
+static int Connect(const std::string& address) {
+  // Coordinator may not be listening yet
+  static const size_t kAttempts = 30;
+
+  for (size_t i = 0; i < kAttempts; ++i) {
+    if (int fd = TryConnect(address); fd >= 0) {
+      return fd;
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+  WHEELS_PANIC("Failed to connect to coordinator at " << address);
+}
+
+// Returns false if peer is gone
+static bool SendLine(int fd, const std::string& line) {
+  std::string data = line + '\n';
+  size_t sent = 0;
+  while (sent < data.size()) {
+    // No SIGPIPE on dead peer
+    ssize_t bytes =
+        ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (bytes <= 0) {
+      return false;
+    }
+    sent += bytes;
+  }
+  return true;
+}
+
+// Extracts complete line from `buffer`
+static bool PopLine(std::string& buffer, std::string& line) {
+  auto eol = buffer.find('\n');
+  if (eol == std::string::npos) {
+    return false;
+  }
+  line = buffer.substr(0, eol);
+  buffer.erase(0, eol + 1);
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Coordinator wakes up to reap local workers and check
+// that some worker is alive
+static const int kPollTimeoutMs = 1000;
+// Sweep without connected workers is abandoned
+static const auto kNoWorkersTimeout = std::chrono::seconds(60);
+
+Coordinator::Coordinator(const std::string& address,
+                         std::vector<size_t> seeds, size_t batch,
+                         std::vector<pid_t> local_workers)
+    : address_(address),
+      listen_fd_(Listen(address)),
+      pending_(seeds.begin(), seeds.end()),
+      total_(seeds.size()),
+      batch_(std::max<size_t>(batch, 1)),
+      local_workers_(std::move(local_workers)),
+      has_local_workers_(!local_workers_.empty()) {
+}
+
+Coordinator::~Coordinator() {
+  for (auto& [fd, _] : peers_) {
+    ::close(fd);
+  }
+  ::close(listen_fd_);
+  if (!IsTcpAddress(address_)) {
+    ::unlink(address_.c_str());
+  }
+}
+
+bool Coordinator::Run(ResultHandler handler) {
+  handler_ = std::move(handler);
+
+  last_peer_time_ = std::chrono::steady_clock::now();
+
+  while (!IsDone()) {
+    std::vector<pollfd> fds;
+    fds.push_back({listen_fd_, POLLIN, 0});
+    for (auto& [fd, _] : peers_) {
+      fds.push_back({fd, POLLIN, 0});
+    }
+
+    int ready = ::poll(fds.data(), fds.size(), kPollTimeoutMs);
+    if (ready < 0) {
+      WHEELS_VERIFY(errno == EINTR, "poll failed");
+      continue;
+    }
+
+    if (fds[0].revents & POLLIN) {
+      Accept();
+    }
+
+    for (size_t i = 1; i < fds.size(); ++i) {
+      if (fds[i].revents == 0) {
+        continue;
+      }
+      auto it = peers_.find(fds[i].fd);
+      if (it != peers_.end() && !Receive(it->second)) {
+        Disconnect(fds[i].fd);
+      }
+    }
+
+    ReapLocalWorkers();
+    AssignIdle();
+
+    if (!HasWorkers(std::chrono::steady_clock::now())) {
+      std::cerr << "Coordinator: no workers left, " << total_ - done_.size()
+                << " of " << total_ << " seeds are not done" << std::endl;
+      break;
+    }
+  }
+
+  for (auto& [fd, _] : peers_) {
+    SendLine(fd, "stop");
+  }
+
+  return IsDone();
+}
+
+void Coordinator::ReapLocalWorkers() {
+  std::erase_if(local_workers_, [](pid_t pid) {
+    int status;
+    if (::waitpid(pid, &status, WNOHANG) != pid) {
+      return false;  // Still running
+    }
+    if (!(WIFEXITED(status) && WEXITSTATUS(status) == 0)) {
+      std::cerr << "Coordinator: local worker " << pid
+                << " exited abnormally" << std::endl;
+    }
+    return true;
+  });
+}
+
+bool Coordinator::HasWorkers(std::chrono::steady_clock::time_point now) {
+  if (!peers_.empty()) {
+    last_peer_time_ = now;
+    return true;
+  }
+  if (has_local_workers_ && local_workers_.empty()) {
+    return false;  // All local workers exited
+  }
+  return now - last_peer_time_ < kNoWorkersTimeout;
+}
+
+void Coordinator::Accept() {
+  int fd = ::accept(listen_fd_, nullptr, nullptr);
+  if (fd >= 0) {
+    peers_.emplace(fd, Peer{fd, {}, {}, false});
+  }
+}
+
+bool Coordinator::Receive(Peer& peer) {
+  char buf[4096];
+  ssize_t bytes = ::read(peer.fd, buf, sizeof(buf));
+  if (bytes <= 0) {
+    return false;
+  }
+  peer.input.append(buf, bytes);
+
+  std::string line;
+  while (PopLine(peer.input, line)) {
+    if (!Handle(peer, line)) {
+      std::cerr << "Coordinator: disconnect worker, malformed message: "
+                << line << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Coordinator::Handle(Peer& peer, const std::string& line) {
+  if (line == "ready") {
+    Assign(peer);
+    return true;
+  }
+
+  static const std::string kResult = "result ";
+
+  if (line.starts_with(kResult)) {
+    auto result = ParseResult(line.substr(kResult.size()));
+    if (!result) {
+      return false;
+    }
+
+    std::erase(peer.seeds, result->seed);
+
+    // Idempotent: seed could be run by several workers
+    if (done_.insert(result->seed).second) {
+      handler_(*result);
+    }
+    return true;
+  }
+
+  return false;  // Unexpected message
+}
+
+void Coordinator::Disconnect(int fd) {
+  auto it = peers_.find(fd);
+  // Worker died: return its unfinished seeds
+  for (size_t seed : it->second.seeds) {
+    if (!done_.contains(seed)) {
+      pending_.push_front(seed);
+    }
+  }
+  ::close(fd);
+  peers_.erase(it);
+}
+
+void Coordinator::Assign(Peer& peer) {
+  std::vector<size_t> seeds;
+  while (!pending_.empty() && seeds.size() < batch_) {
+    size_t seed = pending_.front();
+    pending_.pop_front();
+    if (!done_.contains(seed)) {
+      seeds.push_back(seed);
+    }
+  }
+
+  if (seeds.empty()) {
+    seeds = Steal(peer);
+  }
+
+  if (seeds.empty()) {
+    peer.idle = true;
+    return;
+  }
+
+  std::string message = "work";
+  for (size_t seed : seeds) {
+    message += ' ' + std::to_string(seed);
+  }
+
+  peer.idle = false;
+  peer.seeds.insert(peer.seeds.end(), seeds.begin(), seeds.end());
+
+  // Dead peer is detected on next poll
+  SendLine(peer.fd, message);
+}
+
+std::vector<size_t> Coordinator::Steal(const Peer& thief) {
+  const Peer* victim = nullptr;
+  size_t backlog = 1;  // Do not steal the last running seed
+
+  for (const auto& [_, peer] : peers_) {
+    if (&peer == &thief) {
+      continue;
+    }
+    size_t undone = std::count_if(peer.seeds.begin(), peer.seeds.end(),
+                                  [this](size_t seed) {
+                                    return !done_.contains(seed) &&
+                                           !IsStolen(seed);
+                                  });
+    if (undone > backlog) {
+      backlog = undone;
+      victim = &peer;
+    }
+  }
+
+  if (victim == nullptr) {
+    return {};
+  }
+
+  // Victim runs seeds in order: take the tail half
+  std::vector<size_t> stolen;
+  for (auto it = victim->seeds.rbegin();
+       it != victim->seeds.rend() && stolen.size() < backlog / 2; ++it) {
+    if (!done_.contains(*it) && !IsStolen(*it)) {
+      stolen.push_back(*it);
+    }
+  }
+  std::reverse(stolen.begin(), stolen.end());
+
+  stolen_.insert(stolen.begin(), stolen.end());
+  return stolen;
+}
+
+void Coordinator::AssignIdle() {
+  for (auto& [_, peer] : peers_) {
+    if (peer.idle) {
+      Assign(peer);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void RunWorker(const std::string& address,
+               std::function<SimulationResult(size_t seed)> run) {
+  int fd = Connect(address);
+
+  std::string input;
+  std::string line;
+
+  SendLine(fd, "ready");
+
+  while (true) {
+    while (!PopLine(input, line)) {
+      char buf[4096];
+      ssize_t bytes = ::read(fd, buf, sizeof(buf));
+      if (bytes <= 0) {
+        ::close(fd);
+        return;  // Coordinator is gone
+      }
+      input.append(buf, bytes);
+    }
+
+    if (line == "stop") {
+      break;
+    }
+
+    std::istringstream message{line};
+    std::string tag;
+    message >> tag;
+    WHEELS_VERIFY(tag == "work", "Unexpected message from coordinator: "
+                                     << line);
+
+    size_t seed;
+    while (message >> seed) {
+      auto result = run(seed);
+      if (!SendLine(fd, "result " + FormatResult(result))) {
+        ::close(fd);
+        return;
+      }
+    }
+
+    SendLine(fd, "ready");
+  }
+
+  ::close(fd);
+}
+
+}  // namespace whirl::matrix
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <matrix/test/results.hpp>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+// Distributed seed sweep
+
+// Address: "host:port" (TCP) or filesystem path (Unix socket)
+
+// Line protocol:
+// Worker -> coordinator: "ready", "result <csv>" (see FormatResult)
+// Coordinator -> worker: "work <seed> <seed> ...", "stop"
+
+// Simulations are deterministic per seed, so any seed could be
+// (re)assigned to any worker: results are deduplicated by seed
+
+// Worker that sends a malformed line is disconnected,
+// its seeds are reassigned
+
+//////////////////////////////////////////////////////////////////////
+
+class Coordinator {
+  struct Peer {
+    int fd;
+    std::string input;
+    // Assigned seeds without results yet
+    std::vector<size_t> seeds;
+    bool idle = false;
+  };
+
+ public:
+  using ResultHandler = std::function<void(const SimulationResult&)>;
+
+  // `local_workers` - forked worker processes, reaped by coordinator
+  Coordinator(const std::string& address, std::vector<size_t> seeds,
+              size_t batch, std::vector<pid_t> local_workers = {});
+  ~Coordinator();
+
+  // Returns true when all seeds are done, false if workers are gone:
+  // all local workers exited or no worker connected for a while
+  // `handler` is invoked once per seed
+  bool Run(ResultHandler handler);
+
+ private:
+  void Accept();
+  // Returns false if peer disconnected or sent malformed line
+  bool Receive(Peer& peer);
+  bool Handle(Peer& peer, const std::string& line);
+  void Disconnect(int fd);
+
+  void ReapLocalWorkers();
+  // Returns false if sweep cannot make progress
+  bool HasWorkers(std::chrono::steady_clock::time_point now);
+
+  void Assign(Peer& peer);
+  // Work stealing: tail of the largest backlog of other worker
+  std::vector<size_t> Steal(const Peer& thief);
+  void AssignIdle();
+
+  bool IsDone() const {
+    return done_.size() == total_;
+  }
+
+  bool IsStolen(size_t seed) const {
+    return stolen_.contains(seed);
+  }
+
+ private:
+  std::string address_;
+  int listen_fd_;
+
+  std::deque<size_t> pending_;
+  std::unordered_set<size_t> done_;
+  // Assigned to more than one worker
+  std::unordered_set<size_t> stolen_;
+  size_t total_;
+  size_t batch_;
+
+  std::map<int, Peer> peers_;
+
+  // Local workers not reaped yet
+  std::vector<pid_t> local_workers_;
+  bool has_local_workers_;
+  std::chrono::steady_clock::time_point last_peer_time_;
+
+  ResultHandler handler_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Runs seeds assigned by coordinator until it says stop
+// or disconnects
+void RunWorker(const std::string& address,
+               std::function<SimulationResult(size_t seed)> run);
+
+}  // namespace whirl::matrix
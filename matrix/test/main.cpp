@@ -1,8 +1,11 @@
 #include <matrix/test/main.hpp>
 
 #include <wheels/cmdline/argparse.hpp>
+#include <wheels/support/assert.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <thread>
 
 namespace whirl::matrix {
 
@@ -12,11 +15,27 @@ static void CLI(wheels::ArgumentParser& parser) {
   parser.AddHelpFlag();
 
   parser.Add("det").Flag().Help("Test determinism");
+  parser.Add("det-all").ValueDescr("uint").Optional().Help("Test determinism on given number of seeds");
+  parser.Add("check-step-cache").ValueDescr("uint").Optional().Help("Compare digests with and without next step cache on given number of seeds");
   parser.Add("sims").ValueDescr("uint").Optional().Help("Number of simulations to run");
   parser.Add("seed").ValueDescr("uint").Optional();
+  parser.Add("explore").ValueDescr("uint").Optional().Help("Number of coverage-guided simulations");
+  parser.Add("decisions").ValueDescr("path").Optional().Help("Random decisions for --seed (see --explore)");
+  parser.Add("shrink").Flag().Help("Minimize failing simulation, use with --seed");
+  parser.Add("shrink-runs").ValueDescr("uint").Optional().Help("Max simulations for --shrink");
+  parser.Add("jobs").ValueDescr("uint").Optional().Help("Parallel simulations for --shrink");
   parser.Add("log").ValueDescr("path").Optional();
   parser.Add("trace").ValueDescr("path").Optional();
+  parser.Add("record").ValueDescr("path").Optional().Help("Write decision log");
+  parser.Add("replay").ValueDescr("path").Optional().Help("Replay decision log, use with --seed");
+  parser.Add("replay-from-step").ValueDescr("uint").Optional().Help("Do not log steps before");
   parser.Add("quiet").Flag().Help("Be quiet");
+  parser.Add("swarm").Flag().Help("Random subset of features per simulation");
+  parser.Add("keep-going").Flag().Help("Do not stop --sims at the first failure");
+  parser.Add("results").ValueDescr("path").Optional().Help("Append per-seed results, resume sweep");
+  parser.Add("coordinator").ValueDescr("address").Optional().Help("Distribute --sims to workers, host:port or unix socket path");
+  parser.Add("local-workers").ValueDescr("uint").Optional().Help("Workers to start with --coordinator");
+  parser.Add("worker").ValueDescr("address").Optional().Help("Run simulations for coordinator");
 }
 
 template <typename T>
@@ -44,25 +63,91 @@ int Main(int argc, const char** argv, Simulation sim) {
     runner.WriteTraceTo(args.Get("trace"));
   }
 
+  if (args.Has("record")) {
+    runner.RecordDecisionsTo(args.Get("record"));
+  }
+  if (args.Has("replay")) {
+    runner.ReplayDecisionsFrom(args.Get("replay"));
+  }
+  if (args.Has("replay-from-step")) {
+    runner.LogFromStep(FromString<size_t>(args.Get("replay-from-step")));
+  }
+
   if (args.HasFlag("quiet")) {
     runner.BeQuiet();
   }
 
+  if (args.HasFlag("swarm")) {
+    runner.EnableSwarm();
+  }
+  if (args.HasFlag("keep-going")) {
+    runner.KeepGoing();
+  }
+  if (args.Has("results")) {
+    runner.KeepGoing();
+    runner.WriteResultsTo(args.Get("results"));
+  }
+
   if (args.Has("seed")) {
+    if (args.Has("decisions")) {
+      runner.ReadDecisionsFrom(args.Get("decisions"));
+    }
     size_t seed = FromString<size_t>(args.Get("seed"));
+
+    if (args.HasFlag("shrink")) {
+      size_t max_runs = args.Has("shrink-runs")
+                            ? FromString<size_t>(args.Get("shrink-runs"))
+                            : 1000;
+      size_t jobs = args.Has("jobs")
+                        ? FromString<size_t>(args.Get("jobs"))
+                        : std::max(std::thread::hardware_concurrency(), 1u);
+      runner.Shrink(seed, max_runs, jobs);
+      return 0;
+    }
+
     runner.RunSingleSimulation(seed);
     return 0;
   }
 
+  if (args.Has("worker")) {
+    runner.Work(args.Get("worker"));
+    return 0;
+  }
+
+  if (args.Has("coordinator")) {
+    WHEELS_VERIFY(args.Has("sims"), "--coordinator requires --sims");
+    size_t count = FromString<size_t>(args.Get("sims"));
+    size_t local_workers = args.Has("local-workers")
+                               ? FromString<size_t>(args.Get("local-workers"))
+                               : 0;
+    runner.Coordinate(args.Get("coordinator"), count, local_workers);
+    runner.Congratulate();
+    return 0;
+  }
+
   if (args.HasFlag("det")) {
     runner.TestDeterminism();
   }
 
+  if (args.Has("det-all")) {
+    runner.TestDeterminismAll(FromString<size_t>(args.Get("det-all")));
+  }
+
+  if (args.Has("check-step-cache")) {
+    runner.TestNextStepCache(
+        FromString<size_t>(args.Get("check-step-cache")));
+  }
+
   if (args.Has("sims")) {
     size_t count = FromString<size_t>(args.Get("sims"));
     runner.RunSimulations(count);
   }
 
+  if (args.Has("explore")) {
+    size_t count = FromString<size_t>(args.Get("explore"));
+    runner.Explore(count);
+  }
+
   runner.Congratulate();
 
   return 0;
@@ -0,0 +1,63 @@
+#include <matrix/test/repro.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <fstream>
+#include <sstream>
+
+namespace whirl::matrix {
+
+void WriteRepro(const std::string& path, const Repro& repro) {
+  std::ofstream output(path);
+  WHEELS_VERIFY(!output.fail(), "Failed to open " << path);
+
+  for (const auto& [name, value] : repro.params) {
+    output << "param " << name << ' ' << value;
+    if (auto it = repro.min_params.find(name); it != repro.min_params.end()) {
+      output << ' ' << it->second;
+    }
+    output << '\n';
+  }
+  for (uint64_t value : repro.decisions) {
+    output << value << '\n';
+  }
+}
+
+Repro ReadRepro(const std::string& path) {
+  std::ifstream input(path);
+  WHEELS_VERIFY(!input.fail(), "Failed to open " << path);
+
+  Repro repro;
+
+  std::string line;
+  while (std::getline(input, line)) {
+    if (line.empty()) {
+      continue;
+    }
+
+    std::istringstream fields{line};
+
+    if (line.starts_with("param ")) {
+      std::string tag;
+      std::string name;
+      size_t value;
+      fields >> tag >> name >> value;
+      WHEELS_VERIFY(!fields.fail(), "Invalid parameter in " << path);
+      repro.params[name] = value;
+
+      size_t min;
+      if (fields >> min) {
+        repro.min_params[name] = min;
+      }
+    } else {
+      uint64_t value;
+      fields >> value;
+      WHEELS_VERIFY(!fields.fail(), "Invalid decision in " << path);
+      repro.decisions.push_back(value);
+    }
+  }
+
+  return repro;
+}
+
+}  // namespace whirl::matrix
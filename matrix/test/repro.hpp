@@ -0,0 +1,31 @@
+#pragma once
+
+#include <matrix/world/random_source.hpp>
+
+#include <map>
+#include <string>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+// Simulation input beyond the seed:
+// simulation parameters (see TestRunner::Param) and random decisions
+
+struct Repro {
+  std::map<std::string, size_t> params;
+  // Lower bounds of parameters for shrinking, 0 if missing
+  std::map<std::string, size_t> min_params;
+  RandomDecisions decisions;
+};
+
+// Text format:
+// param <name> <value> [<min>]
+// ...
+// <decision>
+// ...
+
+void WriteRepro(const std::string& path, const Repro& repro);
+Repro ReadRepro(const std::string& path);
+
+}  // namespace whirl::matrix
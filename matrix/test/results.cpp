@@ -0,0 +1,198 @@
+#include <matrix/test/results.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <fmt/core.h>
+
+#include <cctype>
+#include <charconv>
+#include <filesystem>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace whirl::matrix {
+
+static const char* kHeader =
+    "seed,failure,digest,steps,virtual_time,wall_time_ms,features";
+
+//////////////////////////////////////////////////////////////////////
+
+std::string FailureSignature(const std::string& failure) {
+  std::string signature;
+  for (char c : failure) {
+    if (!std::isdigit(static_cast<unsigned char>(c))) {
+      signature += c;
+    }
+  }
+  return signature;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Fields must not contain separators
+static std::string Sanitize(std::string field) {
+  for (char& c : field) {
+    if (c == ',' || c == '\n' || c == '\r') {
+      c = ' ';
+    }
+  }
+  return field;
+}
+
+static std::string FormatFeaturesField(const FeatureSet& features) {
+  std::string str;
+  for (const auto& [name, on] : features) {
+    if (!str.empty()) {
+      str += ';';
+    }
+    str += Sanitize(name);
+    str += on ? "=1" : "=0";
+  }
+  return str;
+}
+
+static FeatureSet ParseFeaturesField(const std::string& str) {
+  FeatureSet features;
+
+  std::istringstream input{str};
+  std::string feature;
+  while (std::getline(input, feature, ';')) {
+    auto eq = feature.rfind('=');
+    if (eq != std::string::npos) {
+      features[feature.substr(0, eq)] = feature.substr(eq + 1) == "1";
+    }
+  }
+  return features;
+}
+
+static std::vector<std::string> SplitFields(const std::string& line) {
+  std::vector<std::string> fields;
+
+  std::istringstream input{line};
+  std::string field;
+  while (std::getline(input, field, ',')) {
+    fields.push_back(field);
+  }
+  // Trailing empty field
+  if (!line.empty() && line.back() == ',') {
+    fields.emplace_back();
+  }
+  return fields;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static bool EndsWithNewline(const std::string& path) {
+  std::ifstream input(path, std::ifstream::binary);
+  WHEELS_VERIFY(!input.fail(), "Failed to open " << path);
+
+  input.seekg(-1, std::ifstream::end);
+  return input.get() == '\n';
+}
+
+ResultsStore::ResultsStore(const std::string& path) {
+  const bool exists = fs::exists(path) && fs::file_size(path) > 0;
+
+  if (exists) {
+    Load(path);
+  }
+
+  file_.open(path, std::ofstream::out | std::ofstream::app);
+  WHEELS_VERIFY(!file_.fail(), "Failed to open " << path);
+
+  if (!exists) {
+    file_ << kHeader << std::endl;
+  } else if (!EndsWithNewline(path)) {
+    // Terminate torn line of interrupted sweep,
+    // otherwise the first appended result is glued to it
+    file_ << std::endl;
+  }
+}
+
+template <typename T>
+static bool ParseUInt(const std::string& str, T& value) {
+  const char* last = str.data() + str.size();
+  auto [end, error] = std::from_chars(str.data(), last, value);
+  return error == std::errc{} && end == last;
+}
+
+std::string FormatResult(const SimulationResult& result) {
+  return fmt::format("{},{},{},{},{},{},{}", result.seed,
+                     Sanitize(result.failure), result.digest, result.steps,
+                     result.virtual_time, result.wall_time_ms,
+                     FormatFeaturesField(result.features));
+}
+
+std::optional<SimulationResult> ParseResult(const std::string& line) {
+  auto fields = SplitFields(line);
+  if (fields.size() != 7) {
+    return std::nullopt;
+  }
+
+  SimulationResult result;
+  result.failure = fields[1];
+  result.features = ParseFeaturesField(fields[6]);
+
+  bool ok = ParseUInt(fields[0], result.seed) &&
+            ParseUInt(fields[2], result.digest) &&
+            ParseUInt(fields[3], result.steps) &&
+            ParseUInt(fields[4], result.virtual_time) &&
+            ParseUInt(fields[5], result.wall_time_ms);
+
+  if (!ok) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void ResultsStore::Load(const std::string& path) {
+  std::ifstream input(path);
+  WHEELS_VERIFY(!input.fail(), "Failed to open " << path);
+
+  std::string line;
+  while (std::getline(input, line)) {
+    if (line.empty() || line == kHeader) {
+      continue;
+    }
+
+    auto result = ParseResult(line);
+    if (!result) {
+      continue;  // Torn write of interrupted sweep
+    }
+
+    seeds_.insert(result->seed);
+    results_.push_back(std::move(*result));
+  }
+}
+
+void ResultsStore::Append(const SimulationResult& result) {
+  file_ << FormatResult(result) << std::endl;
+
+  seeds_.insert(result.seed);
+  results_.push_back(result);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+bool FailureSummary::Add(const SimulationResult& result) {
+  if (!result.Failed()) {
+    return false;
+  }
+  ++failed_runs_;
+  return failures_.emplace(FailureSignature(result.failure), result).second;
+}
+
+void FailureSummary::Print(std::ostream& out, bool swarm) const {
+  out << "Failed simulations: " << failed_runs_
+      << ", distinct failures: " << failures_.size() << std::endl;
+
+  for (const auto& [_, result] : failures_) {
+    out << "  " << result.failure << " (reproduce: --seed " << result.seed
+        << (swarm ? " --swarm" : "") << ")" << std::endl;
+  }
+}
+
+}  // namespace whirl::matrix
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <matrix/test/swarm.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+struct SimulationResult {
+  size_t seed = 0;
+  // Empty if simulation passed
+  std::string failure;
+  size_t digest = 0;
+  size_t steps = 0;
+  uint64_t virtual_time = 0;
+  uint64_t wall_time_ms = 0;
+  FeatureSet features;
+
+  bool Failed() const {
+    return !failure.empty();
+  }
+};
+
+// Failures with the same signature are likely the same bug:
+// failure with digits (seeds, ids, counts) stripped
+std::string FailureSignature(const std::string& failure);
+
+// CSV line:
+// seed,failure,digest,steps,virtual_time,wall_time_ms,features
+std::string FormatResult(const SimulationResult& result);
+std::optional<SimulationResult> ParseResult(const std::string& line);
+
+//////////////////////////////////////////////////////////////////////
+
+// Append-only CSV log of simulation results
+
+class ResultsStore {
+ public:
+  // Loads results of previous sweeps
+  explicit ResultsStore(const std::string& path);
+
+  const std::vector<SimulationResult>& Results() const {
+    return results_;
+  }
+
+  bool Contains(size_t seed) const {
+    return seeds_.contains(seed);
+  }
+
+  void Append(const SimulationResult& result);
+
+ private:
+  void Load(const std::string& path);
+
+ private:
+  std::vector<SimulationResult> results_;
+  std::unordered_set<size_t> seeds_;
+  std::ofstream file_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Failures deduplicated by signature
+
+class FailureSummary {
+ public:
+  // Returns true for the first failure with its signature
+  bool Add(const SimulationResult& result);
+
+  bool IsEmpty() const {
+    return failures_.empty();
+  }
+
+  void Print(std::ostream& out, bool swarm) const;
+
+ private:
+  size_t failed_runs_{0};
+  // Signature -> first result
+  std::map<std::string, SimulationResult> failures_;
+};
+
+}  // namespace whirl::matrix
@@ -2,6 +2,9 @@
 
 #include <matrix/facade/world.hpp>
 
+#include <matrix/test/shrinker.hpp>
+#include <matrix/test/distributed.hpp>
+
 #include <matrix/new/debug.hpp>
 
 #include <wheels/support/assert.hpp>
@@ -9,10 +12,18 @@
 
 #include <fmt/core.h>
 
+#include <algorithm>
 #include <random>
 #include <fstream>
 #include <filesystem>
 
+#include <chrono>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 namespace fs = std::filesystem;
 
 namespace whirl::matrix {
@@ -59,12 +70,144 @@ void TestRunner::TestDeterminism() {
   Report() << "Determinism test is OK" << std::endl;
 }
 
+void TestRunner::TestDeterminismAll(size_t count, uint32_t seq_seed) {
+#if __has_feature(address_sanitizer)
+  std::cerr << "--det-all is incompatible with Address Sanitizer" << std::endl;
+  std::exit(1);
+#endif
+
+  std::mt19937 seeds{seq_seed};
+
+  Report() << "Test determinism on " << count << " seeds..." << std::endl;
+
+  for (size_t i = 1; i <= count; ++i) {
+    const size_t seed = seeds();
+    Verbose() << "Seed " << seed << "..." << std::endl;
+    CheckDeterminism(seed);
+  }
+
+  Report() << "Determinism test is OK" << std::endl;
+}
+
+void TestRunner::TestNextStepCache(size_t count, uint32_t seq_seed) {
+  std::mt19937 seeds{seq_seed};
+
+  Report() << "Test next step cache on " << count << " seeds..."
+           << std::endl;
+
+  for (size_t i = 1; i <= count; ++i) {
+    const size_t seed = seeds();
+    Verbose() << "Seed " << seed << "..." << std::endl;
+
+    size_t cached = RunSimulation(seed);
+
+    next_step_cache_ = false;
+    size_t polled = RunSimulation(seed);
+    next_step_cache_ = true;
+
+    if (cached != polled) {
+      Report() << "Next step cache changes simulation with seed " << seed
+               << ": digest = " << cached << ", without cache = " << polled
+               << std::endl;
+      Fail();
+    }
+  }
+
+  Report() << "Next step cache test is OK" << std::endl;
+}
+
+Checkpoints TestRunner::RunWithCheckpoints(size_t seed,
+                                           CheckpointOptions options) {
+  checkpoints_.emplace();
+  checkpoint_options_ = options;
+
+  RunSimulation(seed);
+
+  Checkpoints checkpoints = std::move(*checkpoints_);
+  checkpoints_.reset();
+  return checkpoints;
+}
+
+// Index of the first mismatch
+static std::optional<size_t> FirstMismatch(const Checkpoints& lhs,
+                                           const Checkpoints& rhs) {
+  size_t common = std::min(lhs.size(), rhs.size());
+  for (size_t i = 0; i < common; ++i) {
+    if (!(lhs[i] == rhs[i])) {
+      return i;
+    }
+  }
+  if (lhs.size() != rhs.size()) {
+    return common;
+  }
+  return std::nullopt;
+}
+
+static std::string FormatCheckpoint(const Checkpoints& checkpoints,
+                                    size_t index) {
+  if (index >= checkpoints.size()) {
+    return "simulation ended";
+  }
+  const auto& checkpoint = checkpoints[index];
+  return fmt::format("step {}, time {}, actor {}, digest {}", checkpoint.step,
+                     checkpoint.time, checkpoint.actor, checkpoint.digest);
+}
+
+void TestRunner::CheckDeterminism(size_t seed) {
+  CheckpointOptions coarse;
+
+  auto run1 = RunWithCheckpoints(seed, coarse);
+  auto run2 = RunWithCheckpoints(seed, coarse);
+
+  auto mismatch = FirstMismatch(run1, run2);
+  if (!mismatch) {
+    return;
+  }
+
+  Report() << "Simulation with seed " << seed
+           << " is not deterministic" << std::endl;
+
+  // Divergence window: (previous checkpoint, mismatch]
+  CheckpointOptions dense = coarse;
+  dense.dense_from = *mismatch > 0 ? run1[*mismatch - 1].step : 0;
+  dense.dense_to = dense.dense_from + coarse.interval;
+
+  auto dense1 = RunWithCheckpoints(seed, dense);
+  auto dense2 = RunWithCheckpoints(seed, dense);
+
+  if (auto first = FirstMismatch(dense1, dense2)) {
+    Report() << "First diverging step:" << std::endl
+             << "  run 1: " << FormatCheckpoint(dense1, *first) << std::endl
+             << "  run 2: " << FormatCheckpoint(dense2, *first) << std::endl;
+
+    if (*first > 0) {
+      Report() << "Last common step: " << FormatCheckpoint(dense1, *first - 1)
+               << std::endl;
+    }
+  } else {
+    Report() << "Divergence did not reproduce, first diverging checkpoint:"
+             << std::endl
+             << "  run 1: " << FormatCheckpoint(run1, *mismatch) << std::endl
+             << "  run 2: " << FormatCheckpoint(run2, *mismatch) << std::endl;
+  }
+
+  Report() << "Rerun with WHIRL_LOG_LEVELS and --replay-from-step "
+           << dense.dense_from << " to compare logs" << std::endl;
+
+  Fail();
+}
+
 void TestRunner::RunSimulations(size_t count, uint32_t seq_seed) {
   #if __has_feature(address_sanitizer)
   std::cerr << "--sims is incompatible with Address Sanitizer" << std::endl;
   std::exit(1);
 #endif
 
+  if (swarm_ || keep_going_) {
+    RunSweep(count, seq_seed);
+    return;
+  }
+
   std::mt19937 seeds{seq_seed};
 
   Report() << "Run " << count << " simulations..." << std::endl;
@@ -92,6 +235,483 @@ void TestRunner::RunSimulations(size_t count, uint32_t seq_seed) {
   }
 }
 
+// Max recorded decisions per simulation
+static const size_t kMaxDecisions = 1 << 16;
+
+// Reports of isolated simulation: "<key> <value>" lines
+static std::string ReadReports(int fd) {
+  std::string reported;
+  char buf[4096];
+  ssize_t bytes;
+  while ((bytes = ::read(fd, buf, sizeof(buf))) > 0) {
+    reported.append(buf, bytes);
+  }
+  return reported;
+}
+
+static std::string ReportedFailure(const std::string& reported) {
+  std::string reason;
+
+  std::istringstream lines{reported};
+  std::string line;
+  while (std::getline(lines, line)) {
+    if (line.starts_with("failure ")) {
+      reason = line.substr(std::strlen("failure "));
+    }
+  }
+  return reason;
+}
+
+void TestRunner::Explore(size_t count, uint32_t seq_seed) {
+#if __has_feature(address_sanitizer)
+  std::cerr << "--explore is incompatible with Address Sanitizer" << std::endl;
+  std::exit(1);
+#endif
+
+  std::mt19937_64 random{seq_seed};
+
+  Corpus corpus;
+  Coverage::Signature total;
+
+  Report() << "Explore " << count << " simulations..." << std::endl;
+
+  decisions_.emplace();
+  coverage_.emplace();
+
+  for (size_t i = 1; i <= count; ++i) {
+    // Fresh seeds keep exploration broad
+    if (corpus.IsEmpty() || random() % 4 == 0) {
+      seed_ = random();
+      prefix_.reset();
+    } else {
+      auto entry = corpus.Mutate(random);
+      seed_ = entry.seed;
+      prefix_ = std::move(entry.decisions);
+    }
+
+    decisions_->clear();
+    coverage_->Clear();
+
+    RunSimulation(*seed_);
+
+    size_t new_elements = MergeCoverage(total, coverage_->GetSignature());
+    if (new_elements > 0) {
+      corpus.Add({*seed_, *decisions_});
+      Verbose() << "Simulation " << i << ": " << new_elements
+                << " new coverage elements, corpus size = " << corpus.Size()
+                << std::endl;
+    }
+  }
+
+  Report() << "Coverage: " << total.size()
+           << " elements, corpus size = " << corpus.Size() << std::endl;
+
+  seed_.reset();
+  prefix_.reset();
+  decisions_.reset();
+  coverage_.reset();
+}
+
+void TestRunner::ReadDecisionsFrom(const std::string& path) {
+  if (!fs::is_regular_file(path)) {
+    Panic(fmt::format("Decisions file not found: {}", path));
+  }
+  SetInput(ReadRepro(path));
+}
+
+void TestRunner::SetInput(const Repro& input) {
+  param_overrides_ = input.params;
+  prefix_ = input.decisions;
+}
+
+size_t TestRunner::Param(const std::string& name, size_t value,
+                         size_t min) {
+  if (auto it = param_overrides_.find(name); it != param_overrides_.end()) {
+    value = std::max(it->second, min);
+  }
+  params_[name] = value;
+  if (min > 0) {
+    min_params_[name] = min;
+  }
+  return value;
+}
+
+bool TestRunner::Feature(const std::string& name, bool value) {
+  if (auto it = features_.find(name); it != features_.end()) {
+    return it->second;
+  }
+
+  const bool on = swarm_ ? IsSwarmFeatureEnabled(current_seed_, name) : value;
+  features_.emplace(name, on);
+
+  ReportToParent("feature", fmt::format("{} {}", name, on ? 1 : 0));
+
+  return on;
+}
+
+void TestRunner::Shrink(size_t seed, size_t max_runs, size_t jobs) {
+#if __has_feature(address_sanitizer)
+  std::cerr << "--shrink is incompatible with Address Sanitizer" << std::endl;
+  std::exit(1);
+#endif
+
+  Report() << "Shrink simulation with seed = " << seed << ", jobs = " << jobs
+           << std::endl;
+
+  seed_ = seed;
+
+  // Record complete input of the failing simulation
+  auto recorded =
+      fs::temp_directory_path() / fmt::format("whirl-failure-{}", seed);
+  Repro initial{param_overrides_, {}, prefix_.value_or(RandomDecisions{})};
+
+  auto failure = RunForked({initial}, recorded)[0];
+  if (!failure) {
+    Panic(fmt::format("Simulation with seed {} does not fail", seed));
+  }
+
+  Repro failing = ReadRepro(recorded);
+
+  Report() << "Failing simulation: " << failing.params.size()
+           << " parameters, " << failing.decisions.size() << " decisions"
+           << std::endl;
+  Report() << "Failure: " << *failure << std::endl;
+
+  // Candidates that fail differently (e.g. on a smaller cluster)
+  // are not reductions of this failure
+  const std::string signature = FailureSignature(*failure);
+
+  Shrinker shrinker(
+      [this, &signature](const std::vector<Repro>& batch) {
+        std::vector<bool> reproduced;
+        for (const auto& failed : RunForked(batch)) {
+          reproduced.push_back(failed &&
+                               FailureSignature(*failed) == signature);
+        }
+        return reproduced;
+      },
+      jobs, max_runs);
+
+  Repro shrunk = shrinker.Shrink(std::move(failing));
+
+  size_t non_zero = std::count_if(shrunk.decisions.begin(),
+                                  shrunk.decisions.end(), [](uint64_t value) {
+                                    return value != 0;
+                                  });
+
+  Report() << "Shrunk in " << shrinker.Runs()
+           << " runs, non-zero decisions: " << non_zero << std::endl;
+
+  for (const auto& [name, value] : shrunk.params) {
+    Report() << "Parameter " << name << " = " << value << std::endl;
+  }
+
+  // Replay smallest failing simulation in this process:
+  // report failure, write its input and exit
+  SetInput(shrunk);
+  decisions_.emplace();
+  repro_path_ =
+      fs::temp_directory_path() / fmt::format("whirl-shrunk-{}", seed);
+
+  RunSimulation(seed);
+
+  Panic("Shrunk simulation does not fail, simulation is not deterministic");
+}
+
+std::vector<std::optional<std::string>> TestRunner::RunForked(
+    const std::vector<Repro>& batch, std::optional<fs::path> repro_path) {
+  std::cout.flush();
+
+  struct Child {
+    pid_t pid;
+    int report_fd;
+  };
+
+  std::vector<Child> children;
+
+  for (const auto& input : batch) {
+    int pipe_fds[2];
+    WHEELS_VERIFY(::pipe(pipe_fds) == 0, "Failed to create pipe");
+
+    pid_t pid = ::fork();
+    WHEELS_VERIFY(pid >= 0, "Failed to fork simulation");
+
+    if (pid == 0) {
+      // Child: silent simulation, exit code 1 on failure,
+      // failure reason is reported to parent
+      ::close(pipe_fds[0]);
+      for (const Child& sibling : children) {
+        ::close(sibling.report_fd);
+      }
+      report_fd_ = pipe_fds[1];
+
+      int dev_null = ::open("/dev/null", O_WRONLY);
+      ::dup2(dev_null, STDOUT_FILENO);
+      ::dup2(dev_null, STDERR_FILENO);
+
+      verbose_ = false;
+      log_path_.reset();
+      trace_path_.reset();
+      record_path_.reset();
+      replay_path_.reset();
+
+      SetInput(input);
+      if (repro_path) {
+        decisions_.emplace();
+        repro_path_ = repro_path;
+      }
+
+      RunSimulation(*seed_);
+      std::exit(0);
+    }
+
+    ::close(pipe_fds[1]);
+    children.push_back({pid, pipe_fds[0]});
+  }
+
+  std::vector<std::optional<std::string>> failures;
+  for (const Child& child : children) {
+    std::string reason = ReportedFailure(ReadReports(child.report_fd));
+    ::close(child.report_fd);
+
+    int status;
+    ::waitpid(child.pid, &status, 0);
+
+    // Crashes (e.g. failed asserts) do not reproduce `Fail`
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 1) {
+      failures.push_back(reason.empty() ? "Fail" : reason);
+    } else {
+      failures.push_back(std::nullopt);
+    }
+  }
+  return failures;
+}
+
+void TestRunner::RunSweep(size_t count, uint32_t seq_seed) {
+  SweepState sweep;
+  StartSweep(sweep);
+
+  Report() << "Run " << count << " simulations, keep going..." << std::endl;
+
+  std::mt19937 seeds{seq_seed};
+
+  for (size_t i = 1; i <= count; ++i) {
+    const size_t seed = seeds();
+
+    // Resume interrupted sweep
+    if (sweep.store && sweep.store->Contains(seed)) {
+      continue;
+    }
+
+    RecordResult(sweep, RunIsolated(seed));
+  }
+
+  FinishSweep(sweep);
+}
+
+void TestRunner::Coordinate(const std::string& address, size_t count,
+                            size_t local_workers, uint32_t seq_seed) {
+  SweepState sweep;
+  StartSweep(sweep);
+
+  // Same seeds as `RunSimulations`
+  std::mt19937 seeds_gen{seq_seed};
+  std::vector<size_t> seeds;
+  for (size_t i = 0; i < count; ++i) {
+    const size_t seed = seeds_gen();
+    if (!(sweep.store && sweep.store->Contains(seed))) {
+      seeds.push_back(seed);
+    }
+  }
+
+  // Single host sweep
+  std::vector<pid_t> workers;
+  for (size_t i = 0; i < local_workers; ++i) {
+    std::cout.flush();
+    pid_t pid = ::fork();
+    WHEELS_VERIFY(pid >= 0, "Failed to fork worker");
+    if (pid == 0) {
+      // Coordinator reports results
+      verbose_ = false;
+      Work(address);
+      std::exit(0);
+    }
+    workers.push_back(pid);
+  }
+
+  Report() << "Coordinate " << seeds.size() << " simulations at " << address
+           << std::endl;
+
+  static const size_t kSeedsPerAssignment = 16;
+
+  bool done;
+  {
+    Coordinator coordinator(address, std::move(seeds), kSeedsPerAssignment,
+                            workers);
+    done = coordinator.Run([this, &sweep](const SimulationResult& result) {
+      RecordResult(sweep, result);
+    });
+  }
+
+  // Workers reaped by coordinator are skipped (ECHILD)
+  for (pid_t pid : workers) {
+    ::waitpid(pid, nullptr, 0);
+  }
+
+  FinishSweep(sweep);
+
+  if (!done) {
+    Panic("Sweep is not complete: workers are gone");
+  }
+}
+
+void TestRunner::Work(const std::string& address) {
+  Report() << "Worker for coordinator at " << address << std::endl;
+
+  RunWorker(address, [this](size_t seed) {
+    auto result = RunIsolated(seed);
+    Verbose() << "Seed " << seed << ": "
+              << (result.Failed() ? result.failure : "ok") << std::endl;
+    return result;
+  });
+}
+
+void TestRunner::StartSweep(SweepState& sweep) {
+  if (results_path_) {
+    sweep.store.emplace(*results_path_);
+    Report() << "Results: " << *results_path_ << ", "
+             << sweep.store->Results().size() << " simulations done before"
+             << std::endl;
+
+    for (const auto& result : sweep.store->Results()) {
+      sweep.failures.Add(result);
+    }
+  }
+}
+
+void TestRunner::RecordResult(SweepState& sweep,
+                              const SimulationResult& result) {
+  if (sweep.store) {
+    sweep.store->Append(result);
+  }
+  sweep.stats.Add(result.features, result.Failed());
+
+  if (result.Failed()) {
+    bool new_failure = sweep.failures.Add(result);
+
+    Report() << "Simulation FAILED: seed = " << result.seed
+             << ", failure = " << result.failure
+             << (swarm_ ? ", features = " + FormatFeatures(result.features)
+                        : "")
+             << (new_failure ? "" : " (duplicate)") << std::endl;
+  } else {
+    Verbose() << "Simulation: seed = " << result.seed
+              << ", digest = " << result.digest
+              << ", steps = " << result.steps
+              << ", wall time = " << result.wall_time_ms << "ms"
+              << std::endl;
+  }
+}
+
+void TestRunner::FinishSweep(SweepState& sweep) {
+  if (swarm_) {
+    sweep.stats.Print(Report());
+  }
+
+  sweep.failures.Print(Report(), swarm_);
+
+  if (!sweep.failures.IsEmpty()) {
+    Fail();
+  }
+}
+
+SimulationResult TestRunner::RunIsolated(size_t seed) {
+  int pipe_fds[2];
+  WHEELS_VERIFY(::pipe(pipe_fds) == 0, "Failed to create pipe");
+
+  std::cout.flush();
+
+  auto start_time = std::chrono::steady_clock::now();
+
+  pid_t pid = ::fork();
+  WHEELS_VERIFY(pid >= 0, "Failed to fork simulation");
+
+  if (pid == 0) {
+    // Child
+    ::close(pipe_fds[0]);
+    report_fd_ = pipe_fds[1];
+
+    int dev_null = ::open("/dev/null", O_WRONLY);
+    ::dup2(dev_null, STDOUT_FILENO);
+    ::dup2(dev_null, STDERR_FILENO);
+
+    RunSimulation(seed);
+    std::exit(0);
+  }
+
+  ::close(pipe_fds[1]);
+
+  std::string reported = ReadReports(pipe_fds[0]);
+  ::close(pipe_fds[0]);
+
+  int status;
+  ::waitpid(pid, &status, 0);
+
+  SimulationResult result;
+  result.seed = seed;
+  result.wall_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now() - start_time)
+                            .count();
+
+  std::string reason;
+
+  std::istringstream lines{reported};
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::istringstream fields{line};
+    std::string key;
+    fields >> key;
+    if (key == "feature") {
+      std::string name;
+      bool on;
+      fields >> name >> on;
+      result.features[name] = on;
+    } else if (key == "digest") {
+      fields >> result.digest;
+    } else if (key == "steps") {
+      fields >> result.steps;
+    } else if (key == "time") {
+      fields >> result.virtual_time;
+    } else if (key == "failure") {
+      std::getline(fields >> std::ws, reason);
+    }
+  }
+
+  if (WIFEXITED(status)) {
+    int code = WEXITSTATUS(status);
+    if (code == 1) {
+      result.failure = reason.empty() ? "Fail" : reason;
+    } else if (code != 0) {
+      result.failure = fmt::format("Exit code {}", code);
+    }
+  } else if (WIFSIGNALED(status)) {
+    result.failure = fmt::format("Crash: {}", ::strsignal(WTERMSIG(status)));
+  }
+
+  return result;
+}
+
+void TestRunner::ReportToParent(const std::string& key,
+                                const std::string& value) {
+  if (report_fd_ < 0) {
+    return;
+  }
+  auto line = fmt::format("{} {}\n", key, value);
+  WHEELS_VERIFY(::write(report_fd_, line.data(), line.size()) ==
+                    (ssize_t)line.size(),
+                "Failed to report to parent");
+}
+
 void TestRunner::Configure(facade::World& world) {
   if (log_path_) {
     world.WriteLogTo(*log_path_);
@@ -99,6 +719,38 @@ void TestRunner::Configure(facade::World& world) {
   if (trace_path_) {
     world.WriteTraceTo(*trace_path_);
   }
+  if (record_path_) {
+    world.RecordDecisionsTo(*record_path_);
+  }
+  if (replay_path_) {
+    world.ReplayDecisionsFrom(*replay_path_);
+  }
+  if (log_from_step_ > 0) {
+    world.LogFromStep(log_from_step_);
+  }
+  if (prefix_) {
+    world.SetRandomPrefix(*prefix_);
+  }
+  if (decisions_) {
+    world.RecordRandomTo(&*decisions_, kMaxDecisions);
+  }
+  if (coverage_) {
+    world.CollectCoverageTo(&*coverage_);
+  }
+  if (checkpoints_) {
+    world.RecordCheckpointsTo(&*checkpoints_, checkpoint_options_);
+  }
+  if (!next_step_cache_) {
+    world.DisableNextStepCache();
+  }
+  if (report_fd_ >= 0) {
+    world.OnStop([this](const facade::World& stopped) {
+      ReportToParent("digest", std::to_string(stopped.Digest()));
+      ReportToParent("steps", std::to_string(stopped.StepCount()));
+      ReportToParent("time",
+                     std::to_string(stopped.TimeElapsed().Count()));
+    });
+  }
 }
 
 void TestRunner::RunSingleSimulation(size_t seed) {
@@ -114,6 +766,12 @@ void TestRunner::RunSingleSimulation(size_t seed) {
 }
 
 size_t TestRunner::RunSimulation(size_t seed) {
+  params_.clear();
+  min_params_.clear();
+  features_.clear();
+  fail_reason_.clear();
+  current_seed_ = seed;
+
   active = this;
   size_t digest = sim_(seed);
   active = nullptr;
@@ -130,6 +788,24 @@ void TestRunner::Congratulate() {
 }
 
 void TestRunner::Fail() {
+  if (decisions_ && seed_) {
+    // Found by exploration / shrinking:
+    // seed alone does not reproduce the failure
+    auto path = repro_path_.value_or(
+        fs::temp_directory_path() / fmt::format("whirl-decisions-{}", *seed_));
+    WriteRepro(path, {params_, min_params_, *decisions_});
+    std::cout << "Reproduce: --seed " << *seed_ << " --decisions "
+              << path.string() << std::endl;
+  }
+
+  if (!fail_reason_.empty()) {
+    ReportToParent("failure", fail_reason_);
+  }
+
+  if (swarm_ && !features_.empty()) {
+    std::cout << "Swarm features: " << FormatFeatures(features_) << std::endl;
+  }
+
   std::cout << "(ﾉಥ益ಥ）ﾉ ┻━┻" << std::endl;
   std::cout.flush();
   std::exit(1);
@@ -170,6 +846,18 @@ void TestRunner::WriteTraceTo(const std::string& path) {
   trace_path_.emplace(path);
 }
 
+void TestRunner::RecordDecisionsTo(const std::string& path) {
+  CheckLogPath(path);
+  record_path_.emplace(path);
+}
+
+void TestRunner::ReplayDecisionsFrom(const std::string& path) {
+  if (!fs::is_regular_file(path)) {
+    Panic(fmt::format("Decision log not found: {}", path));
+  }
+  replay_path_.emplace(path);
+}
+
 void TestRunner::ResetLogFile() {
   auto path = *log_path_;
 
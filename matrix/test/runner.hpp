@@ -4,10 +4,20 @@
 #include <matrix/test/simulation.hpp>
 
 #include <matrix/test/event_log.hpp>
+#include <matrix/test/corpus.hpp>
+#include <matrix/test/repro.hpp>
+#include <matrix/test/swarm.hpp>
+#include <matrix/test/results.hpp>
+
+#include <matrix/world/coverage.hpp>
+#include <matrix/world/checkpoint.hpp>
 
 #include <fmt/core.h>
 
 #include <filesystem>
+#include <map>
+#include <optional>
+#include <vector>
 
 #include <iostream>
 #include <sstream>
@@ -39,12 +49,57 @@ class TestRunner {
 
   void WriteTraceTo(const std::string& path);
 
+  // Swarm testing: enable random subset of features in each simulation
+  void EnableSwarm() {
+    swarm_ = true;
+  }
+
+  // Failures do not stop `RunSimulations`
+  void KeepGoing() {
+    keep_going_ = true;
+  }
+
+  // Append per-seed results, skip seeds already there
+  void WriteResultsTo(const std::string& path) {
+    results_path_.emplace(path);
+  }
+
+  // Decision log
+  void RecordDecisionsTo(const std::string& path);
+  void ReplayDecisionsFrom(const std::string& path);
+  // Skip log events before world step `step`
+  void LogFromStep(size_t step) {
+    log_from_step_ = step;
+  }
+
   // Run
 
   void TestDeterminism();
+  // Run `count` seeds twice, locate first diverging step
+  void TestDeterminismAll(size_t count, uint32_t seq_seed = 42);
+  // Run `count` seeds with and without next step cache,
+  // compare digests
+  void TestNextStepCache(size_t count, uint32_t seq_seed = 42);
   void RunSimulations(size_t count, uint32_t seq_seed = 42);
   void RunSingleSimulation(size_t seed);
 
+  // Coverage-guided exploration: mutate random decisions of
+  // simulations that reached new coverage points
+  void Explore(size_t count, uint32_t seq_seed = 42);
+
+  // Replay simulation found by `Explore` / `Shrink`
+  void ReadDecisionsFrom(const std::string& path);
+
+  // Distributed sweep of `count` seeds (see Coordinator)
+  // `local_workers` - worker processes on this host
+  void Coordinate(const std::string& address, size_t count,
+                  size_t local_workers, uint32_t seq_seed = 42);
+  void Work(const std::string& address);
+
+  // Minimize input of failing simulation, candidates run
+  // in `jobs` forked processes
+  void Shrink(size_t seed, size_t max_runs, size_t jobs);
+
   // Access current test runner
   static TestRunner& Access();
 
@@ -52,6 +107,15 @@ class TestRunner {
 
   void Configure(facade::World& world);
 
+  // Shrinkable simulation parameter (clients, requests, adversaries)
+  // Returns `value` unless overridden by reproduction / shrinking
+  // Shrinking does not go below `min`
+  size_t Param(const std::string& name, size_t value, size_t min = 0);
+
+  // Optional simulation feature: fault kind, time model knob, workload mix
+  // Swarm mode: random subset, otherwise `value`
+  bool Feature(const std::string& name, bool value = true);
+
   std::optional<std::string> LogFile() const {
     return log_path_;
   };
@@ -80,6 +144,7 @@ class TestRunner {
 
   void Fail(std::string reason) {
     std::cout << reason << std::endl;
+    fail_reason_ = reason;
     Fail();
   }
 
@@ -88,6 +153,31 @@ class TestRunner {
  private:
   size_t RunSimulation(size_t seed);
 
+  Checkpoints RunWithCheckpoints(size_t seed, CheckpointOptions options);
+  void CheckDeterminism(size_t seed);
+
+  struct SweepState {
+    std::optional<ResultsStore> store;
+    SwarmStats stats;
+    FailureSummary failures;
+  };
+
+  // Each simulation in a separate process, failures do not stop runner
+  void RunSweep(size_t count, uint32_t seq_seed);
+  void StartSweep(SweepState& sweep);
+  void RecordResult(SweepState& sweep, const SimulationResult& result);
+  void FinishSweep(SweepState& sweep);
+
+  SimulationResult RunIsolated(size_t seed);
+  // Context: isolated simulation
+  void ReportToParent(const std::string& key, const std::string& value);
+
+  void SetInput(const Repro& input);
+  // Failure of each run, std::nullopt if run passed or crashed
+  std::vector<std::optional<std::string>> RunForked(
+      const std::vector<Repro>& batch,
+      std::optional<std::filesystem::path> repro_path = std::nullopt);
+
  private:
   void Cleanup() {
     // Release sink_ memory
@@ -107,8 +197,40 @@ class TestRunner {
   bool verbose_{true};
   std::optional<std::filesystem::path> log_path_;
   std::optional<std::filesystem::path> trace_path_;
+  std::optional<std::filesystem::path> record_path_;
+  std::optional<std::filesystem::path> replay_path_;
+  size_t log_from_step_{0};
 
   std::stringstream sink_;
+
+  // Current simulation input and coverage
+  // Set by `Explore` / `ReadDecisionsFrom`
+  std::optional<size_t> seed_;
+  std::optional<RandomDecisions> prefix_;
+  std::optional<RandomDecisions> decisions_;
+  std::optional<Coverage> coverage_;
+
+  std::map<std::string, size_t> param_overrides_;
+  // Parameters of the current simulation
+  std::map<std::string, size_t> params_;
+  std::map<std::string, size_t> min_params_;
+  // Where `Fail` writes simulation input
+  std::optional<std::filesystem::path> repro_path_;
+
+  bool swarm_{false};
+  size_t current_seed_{0};
+  // Features of the current simulation
+  FeatureSet features_;
+  bool keep_going_{false};
+  std::optional<std::filesystem::path> results_path_;
+  std::string fail_reason_;
+  // Isolated simulation reports results to parent
+  int report_fd_{-1};
+
+  std::optional<Checkpoints> checkpoints_;
+  CheckpointOptions checkpoint_options_;
+
+  bool next_step_cache_{true};
 };
 
 }  // namespace whirl::matrix
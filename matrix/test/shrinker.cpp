@@ -0,0 +1,158 @@
+#include <matrix/test/shrinker.hpp>
+
+#include <algorithm>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+Repro Shrinker::Shrink(Repro failing) {
+  bool progress = true;
+  while (progress && runs_ < max_runs_) {
+    progress = false;
+    // Cheapest and most effective first
+    progress |= ShrinkParams(failing);
+    progress |= ZeroChunks(failing);
+    progress |= ShrinkValues(failing);
+  }
+  return failing;
+}
+
+std::optional<size_t> Shrinker::FirstFailing(
+    const std::vector<Repro>& candidates) {
+  for (size_t begin = 0; begin < candidates.size(); begin += batch_) {
+    if (runs_ >= max_runs_) {
+      return std::nullopt;
+    }
+
+    size_t end = std::min({begin + batch_, candidates.size(),
+                           begin + (max_runs_ - runs_)});
+
+    std::vector<Repro> batch{candidates.begin() + begin,
+                             candidates.begin() + end};
+    auto failed = fails_(batch);
+    runs_ += batch.size();
+
+    for (size_t i = 0; i < failed.size(); ++i) {
+      if (failed[i]) {
+        return begin + i;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+bool Shrinker::ShrinkParams(Repro& repro) {
+  bool progress = false;
+
+  for (auto& [name, value] : repro.params) {
+    size_t min = 0;
+    if (auto it = repro.min_params.find(name); it != repro.min_params.end()) {
+      min = it->second;
+    }
+
+    while (value > min) {
+      // Smallest first
+      std::vector<size_t> values{min, min + (value - min) / 2, value - 1};
+      values.erase(std::unique(values.begin(), values.end()), values.end());
+
+      std::vector<Repro> candidates;
+      for (size_t v : values) {
+        candidates.push_back(repro);
+        candidates.back().params[name] = v;
+      }
+
+      auto first = FirstFailing(candidates);
+      if (!first) {
+        break;
+      }
+      value = values[*first];
+      progress = true;
+    }
+  }
+
+  return progress;
+}
+
+static bool IsZero(const RandomDecisions& decisions, size_t begin,
+                   size_t end) {
+  return std::all_of(decisions.begin() + begin, decisions.begin() + end,
+                     [](uint64_t value) {
+                       return value == 0;
+                     });
+}
+
+bool Shrinker::ZeroChunks(Repro& repro) {
+  bool progress = false;
+
+  auto& decisions = repro.decisions;
+
+  for (size_t chunk = std::max<size_t>(decisions.size() / 2, 1); chunk > 0;
+       chunk /= 2) {
+    size_t begin = 0;
+
+    while (begin < decisions.size() && runs_ < max_runs_) {
+      // Next batch of non-zero chunks
+      std::vector<Repro> candidates;
+      std::vector<size_t> offsets;
+
+      for (size_t i = begin;
+           i < decisions.size() && candidates.size() < batch_; i += chunk) {
+        size_t end = std::min(i + chunk, decisions.size());
+        if (IsZero(decisions, i, end)) {
+          continue;
+        }
+        candidates.push_back(repro);
+        auto& zeroed = candidates.back().decisions;
+        std::fill(zeroed.begin() + i, zeroed.begin() + end, 0);
+        offsets.push_back(i);
+      }
+
+      if (candidates.empty()) {
+        break;
+      }
+
+      if (auto first = FirstFailing(candidates)) {
+        repro = std::move(candidates[*first]);
+        begin = offsets[*first] + chunk;
+        progress = true;
+      } else {
+        begin = offsets.back() + chunk;
+      }
+    }
+  }
+
+  return progress;
+}
+
+bool Shrinker::ShrinkValues(Repro& repro) {
+  bool progress = false;
+
+  auto& decisions = repro.decisions;
+
+  for (size_t i = 0; i < decisions.size() && runs_ < max_runs_; ++i) {
+    // Smallest first: v >> 63, ..., v >> 1
+    std::vector<uint64_t> values;
+    for (size_t shift = 63; shift > 0; --shift) {
+      uint64_t value = decisions[i] >> shift;
+      if (value > 0 && (values.empty() || values.back() != value)) {
+        values.push_back(value);
+      }
+    }
+
+    std::vector<Repro> candidates;
+    for (uint64_t value : values) {
+      candidates.push_back(repro);
+      candidates.back().decisions[i] = value;
+    }
+
+    if (auto first = FirstFailing(candidates)) {
+      decisions[i] = values[*first];
+      progress = true;
+    }
+  }
+
+  return progress;
+}
+
+}  // namespace whirl::matrix
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <matrix/test/repro.hpp>
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+// Delta debugging over failing simulation input:
+// 1) Decrease simulation parameters (clients, requests, adversaries)
+//    down to their lower bounds
+// 2) Zero out chunks of random decisions (delays, faults, choices),
+//    halving chunk size
+// 3) Halve remaining non-zero decisions
+// Candidate is accepted iff simulation still fails the same way
+// (see FailureSignature)
+
+class Shrinker {
+ public:
+  // Runs candidates (possibly in parallel),
+  // returns ones that reproduce the original failure
+  using Predicate = std::function<std::vector<bool>(const std::vector<Repro>&)>;
+
+  Shrinker(Predicate fails, size_t batch, size_t max_runs)
+      : fails_(std::move(fails)), batch_(batch), max_runs_(max_runs) {
+  }
+
+  Repro Shrink(Repro failing);
+
+  size_t Runs() const {
+    return runs_;
+  }
+
+ private:
+  bool ShrinkParams(Repro& repro);
+  bool ZeroChunks(Repro& repro);
+  bool ShrinkValues(Repro& repro);
+
+  // Index of the first failing candidate, in candidates order
+  std::optional<size_t> FirstFailing(const std::vector<Repro>& candidates);
+
+ private:
+  Predicate fails_;
+  size_t batch_;
+  size_t max_runs_;
+  size_t runs_{0};
+};
+
+}  // namespace whirl::matrix
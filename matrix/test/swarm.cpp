@@ -0,0 +1,106 @@
+#include <matrix/test/swarm.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+static uint64_t Mix(uint64_t x) {
+  // SplitMix64 finalizer
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+bool IsSwarmFeatureEnabled(size_t seed, const std::string& feature) {
+  // FNV-1a: portable across standard libraries
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : feature) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  return (Mix(seed ^ Mix(hash)) & 1) == 1;
+}
+
+std::string FormatFeatures(const FeatureSet& features) {
+  std::string enabled;
+  for (const auto& [name, on] : features) {
+    if (on) {
+      if (!enabled.empty()) {
+        enabled += ',';
+      }
+      enabled += name;
+    }
+  }
+  return enabled.empty() ? "-" : enabled;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void SwarmStats::Add(const FeatureSet& features, bool failed) {
+  auto count = [failed](Counters& counters) {
+    ++counters.runs;
+    if (failed) {
+      ++counters.failures;
+    }
+  };
+
+  count(total_);
+  for (const auto& [name, on] : features) {
+    auto& [enabled, disabled] = features_[name];
+    count(on ? enabled : disabled);
+  }
+  count(subsets_[FormatFeatures(features)]);
+}
+
+static double FailureRate(size_t runs, size_t failures) {
+  return runs > 0 ? (double)failures / runs : 0.0;
+}
+
+void SwarmStats::Print(std::ostream& out) const {
+  out << fmt::format("Swarm: {} simulations, {} failures", total_.runs,
+                     total_.failures)
+      << std::endl;
+
+  for (const auto& [name, counters] : features_) {
+    const auto& [enabled, disabled] = counters;
+    out << fmt::format("  {:<24} on: {}/{} failed ({:.3f}), "
+                       "off: {}/{} failed ({:.3f})",
+                       name, enabled.failures, enabled.runs,
+                       FailureRate(enabled.runs, enabled.failures),
+                       disabled.failures, disabled.runs,
+                       FailureRate(disabled.runs, disabled.failures))
+        << std::endl;
+  }
+
+  // Subsets that find failures fastest first
+  std::vector<std::pair<std::string, Counters>> subsets{subsets_.begin(),
+                                                        subsets_.end()};
+  std::stable_sort(subsets.begin(), subsets.end(),
+                   [](const auto& lhs, const auto& rhs) {
+                     return FailureRate(lhs.second.runs, lhs.second.failures) >
+                            FailureRate(rhs.second.runs, rhs.second.failures);
+                   });
+
+  static const size_t kTopSubsets = 10;
+
+  out << "Top feature subsets by failure rate:" << std::endl;
+  for (size_t i = 0; i < std::min(kTopSubsets, subsets.size()); ++i) {
+    const auto& [subset, counters] = subsets[i];
+    if (counters.failures == 0) {
+      break;
+    }
+    out << fmt::format("  {}: {}/{} failed, {:.1f} simulations per failure",
+                       subset, counters.failures, counters.runs,
+                       (double)counters.runs / counters.failures)
+        << std::endl;
+  }
+}
+
+}  // namespace whirl::matrix
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdlib>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+// Swarm testing (Groce et al., ISSTA'12): each simulation runs with
+// a random subset of optional features (fault kinds, time model knobs,
+// workload mixes) enabled
+
+// Feature name -> enabled
+using FeatureSet = std::map<std::string, bool>;
+
+// Coin flip determined by seed and feature name only:
+// does not depend on registration order, does not consume
+// simulation randomness
+bool IsSwarmFeatureEnabled(size_t seed, const std::string& feature);
+
+std::string FormatFeatures(const FeatureSet& features);
+
+//////////////////////////////////////////////////////////////////////
+
+class SwarmStats {
+  struct Counters {
+    size_t runs = 0;
+    size_t failures = 0;
+  };
+
+ public:
+  void Add(const FeatureSet& features, bool failed);
+
+  // Failure rates per feature and per subset
+  void Print(std::ostream& out) const;
+
+ private:
+  Counters total_;
+  // Feature name -> {enabled, disabled}
+  std::map<std::string, std::pair<Counters, Counters>> features_;
+  std::map<std::string, Counters> subsets_;
+};
+
+}  // namespace whirl::matrix
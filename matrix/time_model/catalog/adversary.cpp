@@ -36,16 +36,6 @@ class AdversaryTimeModel : public IServerTimeModel {
     return 1;
   }
 
-  // Database
-
-  bool GetCacheMiss() override {
-    return false;
-  }
-
-  bool IteratorCacheMiss() override {
-    return false;
-  }
-
   // Threads
 
   Jiffies ThreadPause() override {
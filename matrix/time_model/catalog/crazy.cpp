@@ -53,21 +53,21 @@ class CrazyServerTimeModel : public IServerTimeModel {
     return GlobalRandomNumber(10, 50);
   }
 
-  // Database
-
-  bool GetCacheMiss() override {
-    return GlobalRandomNumber(11) == 0;
-  }
-
-  bool IteratorCacheMiss() override {
-    return GlobalRandomNumber(17) == 0;
-  }
-
   // Threads
 
   Jiffies ThreadPause() override {
     return GlobalRandomNumber(5, 50);
   }
+
+  // CPU
+
+  // Mostly short tasks, rare long ones (cache misses, GC pauses)
+  Jiffies TaskCpuTime() override {
+    if (GlobalRandomNumber() % 20 == 0) {
+      return GlobalRandomNumber(10, 50);
+    }
+    return GlobalRandomNumber(1, 3);
+  }
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -0,0 +1,237 @@
+#include <matrix/time_model/catalog/pct.hpp>
+
+#include <matrix/world/global/global.hpp>
+#include <matrix/world/global/random.hpp>
+
+#include <matrix/new/new.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+class PctPriorities {
+  // Priority gap should dominate other sources of delay
+  static const uint64_t kMinDelay = 10;
+  static const uint64_t kPriorityGap = 50;
+
+ public:
+  PctPriorities(size_t depth, size_t max_events)
+      : depth_(depth), max_events_(max_events) {
+    WHEELS_VERIFY(depth >= 1, "PCT depth should be positive");
+    WHEELS_VERIFY(max_events >= 1, "PCT max events should be positive");
+  }
+
+  void Reset() {
+    hosts_ = WorldHostCount();
+
+    order_.clear();
+    lowered_.clear();
+    events_ = 0;
+
+    change_points_.clear();
+    for (size_t i = 1; i < depth_; ++i) {
+      change_points_.push_back(GlobalRandomNumber(1, max_events_ + 1));
+    }
+  }
+
+  Jiffies Delay(const std::string& host) {
+    return DelayOfRank(Rank(host));
+  }
+
+  // Upper bound on Delay
+  // Context: after Reset
+  Jiffies MaxDelay() const {
+    return DelayOfRank(MaxRank());
+  }
+
+  // Data message sent by `host`
+  void CountEvent(const std::string& host) {
+    ++events_;
+    for (size_t i = 0; i < change_points_.size(); ++i) {
+      if (change_points_[i] == events_) {
+        // Priority i + 1 < all initial priorities
+        Lower(host, i + 1);
+      }
+    }
+  }
+
+ private:
+  static uint64_t DelayOfRank(size_t rank) {
+    return kMinDelay + kPriorityGap * rank;
+  }
+
+  // Initial ranks are in [0, hosts), lowered host has
+  // rank order_.size() + (depth - priority) <= (hosts - 1) + (depth - 1)
+  size_t MaxRank() const {
+    return std::max<size_t>(hosts_, 1) + depth_ - 2;
+  }
+
+  // 0 - highest priority
+  size_t Rank(const std::string& host) {
+    if (auto it = FindLowered(host); it != lowered_.end()) {
+      // Lower priority -> higher rank
+      return order_.size() + (depth_ - it->second);
+    }
+
+    auto it = std::find(order_.begin(), order_.end(), host);
+    if (it != order_.end()) {
+      return it - order_.begin();
+    }
+
+    // First event of host: insert at random position,
+    // incremental random permutation
+    size_t rank = GlobalRandomNumber(order_.size() + 1);
+    GlobalAllocatorGuard g;
+    order_.insert(order_.begin() + rank, host);
+    return rank;
+  }
+
+  void Lower(const std::string& host, size_t priority) {
+    GlobalAllocatorGuard g;
+
+    order_.erase(std::remove(order_.begin(), order_.end(), host),
+                 order_.end());
+
+    if (auto it = FindLowered(host); it != lowered_.end()) {
+      it->second = priority;
+    } else {
+      lowered_.emplace_back(host, priority);
+    }
+  }
+
+  std::vector<std::pair<std::string, size_t>>::iterator FindLowered(
+      const std::string& host) {
+    return std::find_if(lowered_.begin(), lowered_.end(),
+                        [&host](const auto& entry) {
+                          return entry.first == host;
+                        });
+  }
+
+ private:
+  const size_t depth_;
+  const size_t max_events_;
+
+  size_t hosts_{0};
+
+  // Initial priorities, highest first
+  std::vector<std::string> order_;
+  // Hosts lowered at change points -> priority in [1, depth)
+  std::vector<std::pair<std::string, size_t>> lowered_;
+
+  std::vector<size_t> change_points_;
+  size_t events_{0};
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class PctServerTimeModel : public IServerTimeModel {
+ public:
+  PctServerTimeModel(PctPriorities* priorities, std::string host)
+      : priorities_(priorities), host_(std::move(host)) {
+  }
+
+  // Clocks
+
+  // [-25, +25]
+  int InitClockDrift() override {
+    return -25 + (int)GlobalRandomNumber(25 * 2 + 1);
+  }
+
+  TimePoint ResetMonotonicClock() override {
+    return GlobalRandomNumber(1, 100);
+  }
+
+  Jiffies InitWallClockOffset() override {
+    return GlobalRandomNumber(1000);
+  }
+
+  // TrueTime
+
+  Jiffies TrueTimeUncertainty() override {
+    return GlobalRandomNumber(5, 50);
+  }
+
+  // Disk
+
+  Jiffies DiskWrite(size_t /*bytes*/) override {
+    return priorities_->Delay(host_);
+  }
+
+  Jiffies DiskRead(size_t /*bytes*/) override {
+    return priorities_->Delay(host_);
+  }
+
+  // Threads
+
+  Jiffies ThreadPause() override {
+    return priorities_->Delay(host_);
+  }
+
+ private:
+  PctPriorities* priorities_;
+  std::string host_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class PctTimeModel : public ITimeModel {
+ public:
+  PctTimeModel(size_t depth, size_t max_events)
+      : priorities_(depth, max_events) {
+  }
+
+  void Initialize() override {
+    priorities_.Reset();
+  }
+
+  TimePoint GlobalStartTime() override {
+    return GlobalRandomNumber(1, 200);
+  }
+
+  // Server
+
+  IServerTimeModelPtr MakeServerModel(const std::string& host) override {
+    return std::make_unique<PctServerTimeModel>(&priorities_, host);
+  }
+
+  // Network
+
+  // Data message and reply from the lowest priority hosts
+  Jiffies EstimateRtt() const override {
+    return 2 * priorities_.MaxDelay().Count();
+  }
+
+  Jiffies FlightTime(const net::IServer* start, const net::IServer* /*end*/,
+                     const net::Packet& packet) override {
+    if (packet.header.type != net::Packet::Type::Data) {
+      // Service packet, do not affect randomness
+      return 50;
+    }
+
+    const auto& host = start->HostName();
+    priorities_.CountEvent(host);
+    return priorities_.Delay(host);
+  }
+
+  commute::rpc::BackoffParams BackoffParams() override {
+    return {50, 1000, 2};
+  }
+
+ private:
+  PctPriorities priorities_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+ITimeModelPtr MakePctTimeModel(size_t depth, size_t max_events) {
+  return std::make_unique<PctTimeModel>(depth, max_events);
+}
+
+}  // namespace whirl::matrix
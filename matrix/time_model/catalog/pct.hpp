@@ -0,0 +1,23 @@
+#pragma once
+
+#include <matrix/time_model/time_model.hpp>
+
+namespace whirl::matrix {
+
+// Heuristic inspired by Probabilistic Concurrency Testing
+// (Burckhardt et al., ASPLOS'10)
+
+// Hosts get distinct random priorities, messages and local delays
+// of higher priority hosts are shorter, so concurrent events tend to be
+// ordered by priority of their hosts.
+// Host sending the i-th of `depth - 1` randomly chosen messages
+// (out of first `max_events`) drops below all initial priorities.
+
+// NB: Priorities only shape delays, delivery is not priority-ordered:
+// a message sent later by a higher priority host can still arrive after
+// earlier low priority messages. So the PCT bound on the probability
+// of hitting a bug of given depth does not hold here
+
+ITimeModelPtr MakePctTimeModel(size_t depth = 3, size_t max_events = 1000);
+
+}  // namespace whirl::matrix
@@ -42,14 +42,17 @@ struct IServerTimeModel {
   virtual Jiffies DiskWrite(size_t bytes) = 0;
   virtual Jiffies DiskRead(size_t bytes) = 0;
 
-  // Database
-
-  virtual bool GetCacheMiss() = 0;
-  virtual bool IteratorCacheMiss() = 0;
-
   // Threads
 
   virtual Jiffies ThreadPause() = 0;
+
+  // CPU
+
+  // Charged for each task on servers with limited CPU cores,
+  // on top of explicit `ChargeCpu`
+  virtual Jiffies TaskCpuTime() {
+    return 0;
+  }
 };
 
 using IServerTimeModelPtr = std::unique_ptr<IServerTimeModel>;
@@ -17,6 +17,12 @@ struct IActor {
   virtual TimePoint NextStepTime() const = 0;
   virtual void Step() = 0;
 
+  // Virtual time that has passed within the current step,
+  // e.g. CPU time charged by running server task
+  virtual uint64_t StepElapsed() const {
+    return 0;
+  }
+
   virtual void Shutdown() = 0;
 };
 
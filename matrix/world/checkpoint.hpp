@@ -0,0 +1,40 @@
+#pragma once
+
+#include <matrix/time/time_point.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+// Rolling digest of simulation state for determinism checks:
+// world digest, random source steps, servers heap usage
+
+struct Checkpoint {
+  size_t step;
+  TimePoint time;
+  // Actor of the last step
+  std::string actor;
+  size_t digest;
+
+  bool operator==(const Checkpoint& that) const = default;
+};
+
+struct CheckpointOptions {
+  // Every `interval` steps
+  size_t interval = 256;
+  // + every step in (dense_from, dense_to]
+  size_t dense_from = 0;
+  size_t dense_to = 0;
+
+  bool IsCheckpoint(size_t step) const {
+    return step % interval == 0 || (step > dense_from && step <= dense_to);
+  }
+};
+
+using Checkpoints = std::vector<Checkpoint>;
+
+}  // namespace whirl::matrix
@@ -0,0 +1,71 @@
+#include <matrix/world/coverage.hpp>
+
+#include <wheels/support/hash.hpp>
+
+#include <cctype>
+#include <functional>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+static size_t HashSkipDigits(std::string_view str) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : str) {
+    if (std::isdigit(static_cast<unsigned char>(c))) {
+      continue;
+    }
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+Coverage::Point Coverage::MakePoint(std::string_view actor,
+                                    std::string_view site) {
+  size_t point = HashSkipDigits(actor);
+  wheels::HashCombine(point, HashSkipDigits(site));
+  return point;
+}
+
+static size_t HitsBucket(size_t hits) {
+  if (hits <= 3) {
+    return hits;
+  }
+  // Floor of log2
+  size_t bucket = 0;
+  while (hits > 1) {
+    hits >>= 1;
+    ++bucket;
+  }
+  return 2 + bucket;
+}
+
+Coverage::Signature Coverage::GetSignature() const {
+  Signature signature;
+  signature.reserve(hits_.size());
+
+  for (const auto& [point, hits] : hits_) {
+    size_t element = point;
+    wheels::HashCombine(element, HitsBucket(hits));
+    signature.insert(element);
+  }
+
+  return signature;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+size_t MergeCoverage(Coverage::Signature& total,
+                     const Coverage::Signature& run) {
+  size_t new_elements = 0;
+  for (uint64_t element : run) {
+    if (total.insert(element).second) {
+      ++new_elements;
+    }
+  }
+  return new_elements;
+}
+
+}  // namespace whirl::matrix
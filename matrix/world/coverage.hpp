@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+// Cheap state coverage signature of a single simulation
+// Coverage points: user `Cover` sites, log sites, fault injections
+
+class Coverage {
+ public:
+  using Point = uint64_t;
+  using Signature = std::unordered_set<uint64_t>;
+
+  // Digits are ignored: "Server-kv-2" ~ "Server-kv-5"
+  static Point MakePoint(std::string_view actor, std::string_view site);
+
+  void Hit(Point point) {
+    ++hits_[point];
+  }
+
+  size_t PointCount() const {
+    return hits_.size();
+  }
+
+  // Points with bucketed hit counts (1, 2, 3, 4-7, 8-15, ...), like AFL
+  Signature GetSignature() const;
+
+  void Clear() {
+    hits_.clear();
+  }
+
+ private:
+  std::unordered_map<Point, size_t> hits_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Returns number of new signature elements
+size_t MergeCoverage(Coverage::Signature& total,
+                     const Coverage::Signature& run);
+
+}  // namespace whirl::matrix
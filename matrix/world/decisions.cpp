@@ -0,0 +1,224 @@
+#include <matrix/world/decisions.hpp>
+
+#include <wheels/support/assert.hpp>
+#include <wheels/support/panic.hpp>
+
+#include <fmt/core.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace whirl::matrix {
+
+static const char* kHeader = "whirl-decisions\n";
+
+//////////////////////////////////////////////////////////////////////
+
+DecisionRecorder::DecisionRecorder(const std::string& path) {
+  file_ = std::fopen(path.c_str(), "wb");
+  WHEELS_VERIFY(file_ != nullptr, "Failed to open " << path);
+  std::fputs(kHeader, file_);
+}
+
+DecisionRecorder::~DecisionRecorder() {
+  std::fclose(file_);
+}
+
+void DecisionRecorder::Record(size_t step, const std::string& actor,
+                              const std::source_location& site,
+                              uint64_t value) {
+  uint32_t actor_id = ActorId(actor);
+  uint32_t site_id = SiteId(site);
+
+  std::fputc('D', file_);
+  WriteVarint(step - last_step_);
+  WriteVarint(actor_id);
+  WriteVarint(site_id);
+  WriteVarint(value);
+
+  last_step_ = step;
+}
+
+uint32_t DecisionRecorder::ActorId(const std::string& actor) {
+  if (auto it = actors_.find(actor); it != actors_.end()) {
+    return it->second;
+  }
+
+  std::fputc('A', file_);
+  WriteString(actor);
+
+  uint32_t id = actors_.size();
+  actors_.emplace(actor, id);
+  return id;
+}
+
+uint32_t DecisionRecorder::SiteId(const std::source_location& site) {
+  auto key = std::make_pair(site.file_name(), site.line());
+  if (auto it = sites_.find(key); it != sites_.end()) {
+    return it->second;
+  }
+
+  std::fputc('S', file_);
+  WriteVarint(site.line());
+  WriteString(site.file_name());
+  WriteString(site.function_name());
+
+  uint32_t id = sites_.size();
+  sites_.emplace(key, id);
+  return id;
+}
+
+void DecisionRecorder::WriteVarint(uint64_t value) {
+  while (value >= 0x80) {
+    std::fputc(static_cast<int>((value & 0x7f) | 0x80), file_);
+    value >>= 7;
+  }
+  std::fputc(static_cast<int>(value), file_);
+}
+
+void DecisionRecorder::WriteString(const std::string& str) {
+  WriteVarint(str.size());
+  std::fwrite(str.data(), 1, str.size(), file_);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+class Reader {
+ public:
+  explicit Reader(std::vector<char> data) : data_(std::move(data)) {
+  }
+
+  bool IsEmpty() const {
+    return pos_ == data_.size();
+  }
+
+  char ReadChar() {
+    WHEELS_VERIFY(!IsEmpty(), "Truncated decision log");
+    return data_[pos_++];
+  }
+
+  uint64_t ReadVarint() {
+    uint64_t value = 0;
+    for (size_t shift = 0;; shift += 7) {
+      WHEELS_VERIFY(shift < 64, "Malformed varint in decision log");
+      uint8_t byte = ReadChar();
+      value |= uint64_t(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+  }
+
+  std::string ReadString() {
+    size_t size = ReadVarint();
+    WHEELS_VERIFY(data_.size() - pos_ >= size, "Truncated decision log");
+    std::string str(data_.data() + pos_, size);
+    pos_ += size;
+    return str;
+  }
+
+  void Skip(size_t bytes) {
+    pos_ += bytes;
+  }
+
+ private:
+  std::vector<char> data_;
+  size_t pos_ = 0;
+};
+
+}  // namespace
+
+DecisionReplayer::DecisionReplayer(const std::string& path) {
+  Load(path);
+}
+
+void DecisionReplayer::Load(const std::string& path) {
+  std::ifstream input(path, std::ios::binary);
+  WHEELS_VERIFY(!input.fail(), "Failed to open " << path);
+
+  std::vector<char> data{std::istreambuf_iterator<char>(input),
+                         std::istreambuf_iterator<char>()};
+
+  const size_t header_size = std::strlen(kHeader);
+  WHEELS_VERIFY(data.size() >= header_size &&
+                    std::memcmp(data.data(), kHeader, header_size) == 0,
+                "Not a decision log: " << path);
+
+  Reader reader{std::move(data)};
+  reader.Skip(header_size);
+
+  size_t step = 0;
+
+  while (!reader.IsEmpty()) {
+    switch (reader.ReadChar()) {
+      case 'A':
+        actors_.push_back(reader.ReadString());
+        break;
+      case 'S': {
+        DecisionSite site;
+        site.line = reader.ReadVarint();
+        site.file = reader.ReadString();
+        site.function = reader.ReadString();
+        sites_.push_back(std::move(site));
+        break;
+      }
+      case 'D': {
+        Decision decision;
+        step += reader.ReadVarint();
+        decision.step = step;
+        decision.actor = reader.ReadVarint();
+        decision.site = reader.ReadVarint();
+        decision.value = reader.ReadVarint();
+        WHEELS_VERIFY(decision.actor < actors_.size() &&
+                          decision.site < sites_.size(),
+                      "Malformed decision log");
+        decisions_.push_back(decision);
+        break;
+      }
+      default:
+        WHEELS_PANIC("Malformed decision log: " << path);
+    }
+  }
+}
+
+std::string DecisionReplayer::Format(const Decision& decision) const {
+  const auto& site = sites_[decision.site];
+  return fmt::format("step {}, actor {}, {}:{} ({})", decision.step,
+                     actors_[decision.actor], site.file, site.line,
+                     site.function);
+}
+
+uint64_t DecisionReplayer::Replay(size_t step, const std::string& actor,
+                                  const std::source_location& site) {
+  auto actual = [&]() {
+    return fmt::format("step {}, actor {}, {}:{} ({})", step, actor,
+                       site.file_name(), site.line(), site.function_name());
+  };
+
+  if (next_ == decisions_.size()) {
+    WHEELS_PANIC("Replay diverged after " << next_
+                                          << " decisions: log exhausted at "
+                                          << actual());
+  }
+
+  const Decision& expected = decisions_[next_];
+  const auto& expected_site = sites_[expected.site];
+
+  bool match = expected.step == step && actors_[expected.actor] == actor &&
+               expected_site.file == site.file_name() &&
+               expected_site.function == site.function_name();
+
+  if (!match) {
+    WHEELS_PANIC("Replay diverged at decision #"
+                 << next_ << ": expected " << Format(expected) << ", actual "
+                 << actual());
+  }
+
+  ++next_;
+  return expected.value;
+}
+
+}  // namespace whirl::matrix
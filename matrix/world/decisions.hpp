@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <source_location>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace whirl::matrix {
+
+//////////////////////////////////////////////////////////////////////
+
+// Decision log: every random number consumed by simulation,
+// tagged with world step, actor and call site
+
+// Format: "whirl-decisions\n" + stream of records
+// 'A' <len> <name>                      - new actor
+// 'S' <line> <len> <file> <len> <func>  - new call site
+// 'D' <step delta> <actor> <site> <value>
+// Integers are LEB128 varints, actors and sites are referenced by
+// order of appearance
+
+struct DecisionSite {
+  std::string file;
+  uint32_t line;
+  std::string function;
+};
+
+struct Decision {
+  size_t step;
+  uint32_t actor;
+  uint32_t site;
+  uint64_t value;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Streams records to file: log survives `std::exit` in failed simulation
+
+class DecisionRecorder {
+ public:
+  explicit DecisionRecorder(const std::string& path);
+  ~DecisionRecorder();
+
+  void Record(size_t step, const std::string& actor,
+              const std::source_location& site, uint64_t value);
+
+ private:
+  uint32_t ActorId(const std::string& actor);
+  uint32_t SiteId(const std::source_location& site);
+
+  void WriteVarint(uint64_t value);
+  void WriteString(const std::string& str);
+
+ private:
+  std::FILE* file_;
+
+  size_t last_step_{0};
+  std::unordered_map<std::string, uint32_t> actors_;
+  // Key: (file, line), file name pointers are stable
+  std::map<std::pair<const char*, uint32_t>, uint32_t> sites_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Feeds recorded values back, panics at the first divergence
+// Call sites are matched by file and function, so unrelated
+// code edits do not break replay
+
+class DecisionReplayer {
+ public:
+  explicit DecisionReplayer(const std::string& path);
+
+  uint64_t Replay(size_t step, const std::string& actor,
+                  const std::source_location& site);
+
+  size_t Replayed() const {
+    return next_;
+  }
+
+ private:
+  void Load(const std::string& path);
+
+  std::string Format(const Decision& decision) const;
+
+ private:
+  std::vector<std::string> actors_;
+  std::vector<DecisionSite> sites_;
+  std::vector<Decision> decisions_;
+
+  size_t next_{0};
+};
+
+}  // namespace whirl::matrix
@@ -1,4 +1,5 @@
 #include <matrix/world/global/global.hpp>
+#include <matrix/world/global/coverage.hpp>
 
 #include <matrix/world/world.hpp>
 
@@ -18,14 +19,26 @@ size_t WorldSeed() {
 
 //////////////////////////////////////////////////////////////////////
 
-uint64_t GlobalRandomNumber() {
-  return ThisWorld()->RandomNumber();
+uint64_t GlobalRandomNumber(std::source_location site) {
+  return ThisWorld()->RandomNumber(site);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void Cover(std::string_view site) {
+  ThisWorld()->Cover(site);
 }
 
 //////////////////////////////////////////////////////////////////////
 
 TimePoint GlobalNow() {
-  return ThisWorld()->Now();
+  World* world = ThisWorld();
+
+  // Local time of running actor
+  if (IActor* actor = world->CurrentActor()) {
+    return world->Now() + actor->StepElapsed();
+  }
+  return world->Now();
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -54,6 +67,10 @@ bool IsThereAdversary() {
   return ThisWorld()->HasAdversary();
 }
 
+size_t WorldHostCount() {
+  return ThisWorld()->HostCount();
+}
+
 //////////////////////////////////////////////////////////////////////
 
 HistoryRecorder& GetHistoryRecorder() {
@@ -86,6 +103,10 @@ IActor* ThisActor() {
   return ThisWorld()->CurrentActor();
 }
 
+void InvalidateActor(IActor* actor) {
+  ThisWorld()->InvalidateActor(actor);
+}
+
 //////////////////////////////////////////////////////////////////////
 
 std::string GenerateGuid() {
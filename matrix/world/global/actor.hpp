@@ -7,4 +7,7 @@ namespace whirl::matrix {
 bool AmIActor();
 IActor* ThisActor();
 
+// Next step of `actor` changed outside of its own step
+void InvalidateActor(IActor* actor);
+
 }  // namespace whirl::matrix
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string_view>
+
+namespace whirl::matrix {
+
+// Coverage point for exploration mode (see TestRunner::Explore)
+// Cheap no-op if coverage is not collected
+void Cover(std::string_view site);
+
+}  // namespace whirl::matrix
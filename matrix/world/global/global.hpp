@@ -27,6 +27,9 @@ size_t WorldStepNumber();
 
 bool IsThereAdversary();
 
+// Servers, clients and adversaries
+size_t WorldHostCount();
+
 HistoryRecorder& GetHistoryRecorder();
 
 std::vector<std::string> GetPool(const std::string& name);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdlib>
+#include <source_location>
 #include <vector>
 
 #include <wheels/support/assert.hpp>
@@ -8,18 +9,27 @@
 namespace whirl::matrix {
 
 // Deterministic randomness
+// Call site is recorded to decision log (see World::RecordDecisionsTo)
 
-uint64_t GlobalRandomNumber();
+uint64_t GlobalRandomNumber(
+    std::source_location site = std::source_location::current());
 
 // [0, bound)
-uint64_t GlobalRandomNumber(uint64_t bound);
+uint64_t GlobalRandomNumber(
+    uint64_t bound,
+    std::source_location site = std::source_location::current());
 
 // [lo, hi)
-uint64_t GlobalRandomNumber(uint64_t lo, uint64_t hi);
+uint64_t GlobalRandomNumber(
+    uint64_t lo, uint64_t hi,
+    std::source_location site = std::source_location::current());
 
 // Ordered selection without repetitions
+// Draws are recorded at the call site of GlobalRandomSelect
 template <typename T>
-std::vector<T> GlobalRandomSelect(std::vector<T> items, size_t k) {
+std::vector<T> GlobalRandomSelect(
+    std::vector<T> items, size_t k,
+    std::source_location site = std::source_location::current()) {
   WHEELS_VERIFY(k <= items.size(), "K > items.size()");
 
   std::vector<T> selected;
@@ -27,7 +37,7 @@ std::vector<T> GlobalRandomSelect(std::vector<T> items, size_t k) {
 
   for (size_t i = 0; i < k; ++i) {
     // j \in [i, items.size())
-    int j = GlobalRandomNumber(i, items.size());
+    int j = GlobalRandomNumber(i, items.size(), site);
     std::swap(items[i], items[j]);
     selected.push_back(items[i]);
   }
@@ -6,14 +6,15 @@ namespace whirl::matrix {
 
 // size_t GlobalRandomNumber() defined in global.cpp
 
-uint64_t GlobalRandomNumber(uint64_t bound) {
+uint64_t GlobalRandomNumber(uint64_t bound, std::source_location site) {
   WHEELS_VERIFY(bound > 0, "bound = 0");
-  return GlobalRandomNumber() % bound;
+  return GlobalRandomNumber(site) % bound;
 }
 
-uint64_t GlobalRandomNumber(uint64_t lo, uint64_t hi) {
+uint64_t GlobalRandomNumber(uint64_t lo, uint64_t hi,
+                            std::source_location site) {
   WHEELS_VERIFY(lo <= hi, "Invalid range");
-  return lo + GlobalRandomNumber(hi - lo);
+  return lo + GlobalRandomNumber(hi - lo, site);
 }
 
 }  // namespace whirl::matrix
@@ -1,39 +1,148 @@
 #pragma once
 
-#include <random>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace whirl::matrix {
 
-class RandomSource {
-  // NB: Consistent across all platforms
-  // https://eel.is/c++draft/rand.eng.mers
-  using Impl = std::mt19937;
+// Sequence of values produced by random source
+using RandomDecisions = std::vector<uint64_t>;
+
+//////////////////////////////////////////////////////////////////////
+
+// Counter-based SplitMix64 stream: i-th value is Mix(key + i * gamma)
+// Two words of state: O(1) to copy, checkpoint and fork
+// NB: Consistent across all platforms
+
+class RandomStream {
+  static constexpr uint64_t kGamma = 0x9E3779B97F4A7C15ull;
 
  public:
-  using ResultType = Impl::result_type;
+  explicit RandomStream(uint64_t key = 0) : key_(key) {
+  }
+
+  uint64_t Next() {
+    return Mix(key_ + (++counter_) * kGamma);
+  }
+
+  // Number of values drawn
+  uint64_t Counter() const {
+    return counter_;
+  }
+
+  // Independent stream, does not advance this one
+  RandomStream Fork(uint64_t salt) const {
+    return RandomStream{Mix(key_ ^ MixSalt(salt))};
+  }
+
+  static uint64_t Mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+ private:
+  // Different finalizer: forked keys are not values of this stream
+  static uint64_t MixSalt(uint64_t z) {
+    z = (z ^ (z >> 33)) * 0xFF51AFD7ED558CCDull;
+    z = (z ^ (z >> 33)) * 0xC4CEB9FE1A85EC53ull;
+    return z ^ (z >> 33);
+  }
+
+ private:
+  uint64_t key_;
+  uint64_t counter_{0};
+};
 
+//////////////////////////////////////////////////////////////////////
+
+// Independent stream per actor / subsystem, derived from the world seed:
+// draws in one stream do not perturb decisions of others
+
+class RandomSource {
  public:
-  RandomSource(ResultType seed) {
+  RandomSource(uint64_t seed) {
     Reset(seed);
   }
 
-  void Reset(ResultType seed) {
+  void Reset(uint64_t seed) {
     steps_ = 0;
-    impl_.seed(seed);
+    root_ = RandomStream{RandomStream::Mix(seed)};
+    streams_.clear();
+  }
+
+  // Stream for actor or subsystem `name`
+  // Created on first access, address is stable
+  RandomStream* Stream(std::string_view name) {
+    std::string key{name};
+
+    auto it = streams_.find(key);
+    if (it == streams_.end()) {
+      RandomStream stream = root_.Fork(HashName(name));
+      it = streams_.emplace(std::move(key), stream).first;
+    }
+    return &it->second;
+  }
+
+  // First decisions are taken from `prefix`,
+  // generator is advanced anyway
+  void SetPrefix(RandomDecisions prefix) {
+    prefix_ = std::move(prefix);
+  }
+
+  // Records first `limit` decisions to `sink`
+  void RecordTo(RandomDecisions* sink, size_t limit) {
+    sink_ = sink;
+    record_limit_ = limit;
   }
 
-  ResultType Next() {
+  bool IsRecording() const {
+    return sink_ != nullptr && sink_->size() < record_limit_;
+  }
+
+  // Prefix and recording follow the global order of draws
+  uint64_t Next(RandomStream& stream) {
+    uint64_t value = stream.Next();
+
+    if (steps_ < prefix_.size()) {
+      value = prefix_[steps_];
+    }
+    if (IsRecording()) {
+      sink_->push_back(value);
+    }
+
     ++steps_;
-    return impl_();
+    return value;
   }
 
+  // Total draws across all streams
   size_t Steps() const {
     return steps_;
   }
 
  private:
-  Impl impl_;
+  // FNV-1a: portable across standard libraries
+  static uint64_t HashName(std::string_view name) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (char c : name) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 0x100000001B3ull;
+    }
+    return hash;
+  }
+
+ private:
+  RandomStream root_;
+  std::unordered_map<std::string, RandomStream> streams_;
   size_t steps_ = 0;
+
+  RandomDecisions prefix_;
+
+  RandomDecisions* sink_{nullptr};
+  size_t record_limit_{0};
 };
 
 }  // namespace whirl::matrix
@@ -6,6 +6,7 @@
 
 #include <timber/log.hpp>
 
+#include <algorithm>
 #include <cstdlib>
 
 namespace whirl::matrix {
@@ -14,12 +15,12 @@ namespace whirl::matrix {
 
 static World* this_world = nullptr;
 
-World::WorldGuard::WorldGuard(World* world) {
+World::WorldGuard::WorldGuard(World* world) : prev(this_world) {
   this_world = world;
 }
 
 World::WorldGuard::~WorldGuard() {
-  this_world = nullptr;
+  this_world = prev;
 }
 
 World* World::Access() {
@@ -29,13 +30,20 @@ World* World::Access() {
 
 //////////////////////////////////////////////////////////////////////
 
+// Below: linear scan of cached next step times is faster than heap
+static const size_t kNextStepHeapMinActors = 256;
+
+//////////////////////////////////////////////////////////////////////
+
 ITimeModelPtr World::DefaultTimeModel() {
   return MakeCrazyTimeModel();
 }
 
 void World::SetConfigGlobals() {
   // RTT estimation
-  Jiffies rtt = time_model_->EstimateRtt();
+  // Worst-case link
+  Jiffies rtt = time_model_->EstimateRtt().Count() +
+                network_.GetTopology().MaxRtt().Count();
   SetGlobal("config.net.rtt", (int64_t)rtt.Count());
 }
 
@@ -44,6 +52,8 @@ void World::Start() {
 
   SetupMatrixRuntime();
 
+  log_backend_.Mute(log_from_step_ > 0);
+
   LOG_INFO("Seed: {}", seed_);
 
   SetStartTime();
@@ -82,52 +92,219 @@ void World::Start() {
     Scope(adversary)->Start();
   }
 
+  next_step_heap_ = actors_.size() >= kNextStepHeapMinActors;
+  InvalidateAllNextSteps();
+
   LOG_INFO("World started");
 }
 
 bool World::Step() {
+  return RunSteps(1, nullptr) == 1;
+}
+
+size_t World::RunSteps(size_t max_steps, const StopCondition& done) {
   WorldGuard g(this);
 
-  auto next = FindNextStep();
-  if (!next.has_value()) {
-    return false;
+  size_t steps_made = 0;
+
+  while (steps_made < max_steps && !(done && done())) {
+    auto next = FindNextStep();
+    if (!next.has_value()) {
+      break;  // Deadlock
+    }
+
+    if (next_step_cache_ && next->time > time_.Now()) {
+      steps_made += MakeBulkStep(*next, max_steps - steps_made, done);
+    } else {
+      TakeStep(*next);
+      ++steps_made;
+    }
+  }
+
+  return steps_made;
+}
+
+size_t World::MakeBulkStep(const NextStep& first, size_t max_steps,
+                           const StopCondition& done) {
+  const TimePoint time = first.time;
+
+  bulk_batch_.clear();
+  for (size_t i = actors_.size(); i-- > 0;) {
+    if (next_step_times_[i] == time) {
+      bulk_batch_.push_back(i);
+    }
+  }
+
+  size_t steps_made = 0;
+
+  while (!bulk_batch_.empty() && steps_made < max_steps) {
+    if (steps_made > 0 && done && done()) {
+      break;
+    }
+
+    size_t index = bulk_batch_.back();
+    bulk_batch_.pop_back();
+
+    TakeStep({actors_[index], index, time});
+    ++steps_made;
+
+    // Same refresh as in `FindNextStep`, but only touched actors
+    // are matched against the batch
+    InvalidateNextStep(&network_);
+    bulk_touched_.assign(stale_next_steps_.begin(), stale_next_steps_.end());
+    RefreshNextSteps();
+
+    for (size_t i : bulk_touched_) {
+      std::erase(bulk_batch_, i);
+      if (next_step_times_[i] == time) {
+        // Keep descending order
+        bulk_batch_.insert(std::upper_bound(bulk_batch_.begin(),
+                                            bulk_batch_.end(), i,
+                                            std::greater<>()),
+                           i);
+      }
+    }
   }
 
+  skipped_steps_ += steps_made - 1;
+
+  return steps_made;
+}
+
+void World::TakeStep(const NextStep& next) {
   ++step_number_;
 
-  digest_.Eat(next->time).Eat(next->actor_index);
+  if (step_number_ == log_from_step_) {
+    log_backend_.Mute(false);
+  }
+
+  MakeStep(next);
+
+  if (checkpoints_ != nullptr &&
+      checkpoint_options_.IsCheckpoint(step_number_)) {
+    MakeCheckpoint(next.actor);
+  }
+}
+
+void World::MakeCheckpoint(const IActor* actor) {
+  DigestCalculator digest;
+  digest.Combine(digest_.GetDigest()).Eat(random_source_.Steps());
+
+  // Memory leaks and nondeterministic allocations
+  for (const auto& [_, pool] : pools_) {
+    for (const auto& server : pool) {
+      digest.Eat(server.HeapBytesAllocated());
+    }
+  }
+  for (const auto& client : clients_) {
+    digest.Eat(client.HeapBytesAllocated());
+  }
+
+  checkpoints_->push_back({step_number_, time_.Now(),
+                           actor != nullptr ? actor->Name() : "-",
+                           digest.GetValue()});
+}
+
+void World::MakeStep(const NextStep& next) {
+  digest_.Eat(next.time).Eat(next.actor_index);
 
-  time_.FastForwardTo(next->time);
+  time_.FastForwardTo(next.time);
 
   // For determinism violation debugging
   LOG_TRACE("Next step: {}, actor: {}, random source touched: {} times",
-            step_number_, next->actor->Name(), random_source_.Steps());
+            step_number_, next.actor->Name(), random_source_.Steps());
 
-  Scope(next->actor)->Step();
+  Scope(next.actor)->Step();
 
-  return true;
+  InvalidateAfterStep(next.actor);
 }
 
 std::optional<NextStep> World::FindNextStep() {
-  if (actors_.empty()) {
+  if (next_step_cache_) {
+    // Faults could be injected into network between steps
+    InvalidateNextStep(&network_);
+  } else {
+    InvalidateAllNextSteps();
+  }
+  RefreshNextSteps();
+
+  if (next_step_heap_) {
+    while (!next_steps_.IsEmpty()) {
+      const NextStepEntry& next = next_steps_.Smallest();
+      if (next.version == next_step_versions_[next.actor_index]) {
+        return NextStep{actors_[next.actor_index], next.actor_index,
+                        next.time};
+      }
+      // Superseded by later refresh
+      next_steps_.Extract();
+    }
     return std::nullopt;
   }
 
-  std::optional<NextStep> next_step;
+  // Earliest time, lowest index on ties
+  std::optional<NextStep> best;
+  for (size_t i = 0; i < next_step_times_.size(); ++i) {
+    const auto& time = next_step_times_[i];
+    if (time.has_value() && (!best.has_value() || *time < best->time)) {
+      best = NextStep{actors_[i], i, *time};
+    }
+  }
+  return best;
+}
+
+void World::InvalidateNextStep(IActor* actor) {
+  stale_next_steps_.push_back(actor_indices_.at(actor));
+}
 
+void World::InvalidateAllNextSteps() {
   for (size_t i = 0; i < actors_.size(); ++i) {
+    stale_next_steps_.push_back(i);
+  }
+}
+
+void World::InvalidateAfterStep(IActor* actor) {
+  InvalidateNextStep(actor);
+
+  // Network is refreshed before each step
+
+  if (actor == &network_) {
+    // Packet delivered
+    if (auto* receiver = dynamic_cast<IActor*>(network_.LastReceiver())) {
+      InvalidateNextStep(receiver);
+    }
+  }
+  // Fault injection: see `InvalidateActor`
+}
+
+void World::InvalidateActor(IActor* actor) {
+  GlobalAllocatorGuard g;
+
+  // Actors are unregistered on stop
+  if (actor_indices_.contains(actor)) {
+    InvalidateNextStep(actor);
+  }
+}
+
+void World::RefreshNextSteps() {
+  for (size_t i : stale_next_steps_) {
     IActor* actor = actors_[i];
 
+    std::optional<TimePoint> next_step_time;
     if (actor->IsRunnable()) {
-      TimePoint next_step_time = actor->NextStepTime();
+      next_step_time = actor->NextStepTime();
+    }
 
-      if (!next_step || next_step_time < next_step->time) {
-        next_step = {actor, i, next_step_time};
-      }
+    if (next_step_time == next_step_times_[i]) {
+      continue;  // Heap entry is still live
     }
-  }
 
-  return next_step;
+    next_step_times_[i] = next_step_time;
+    uint64_t version = ++next_step_versions_[i];
+    if (next_step_heap_ && next_step_time.has_value()) {
+      next_steps_.Insert({*next_step_time, i, version});
+    }
+  }
+  stale_next_steps_.clear();
 }
 
 size_t World::Stop() {
@@ -138,6 +315,11 @@ size_t World::Stop() {
   std::exit(0);
 #endif
 
+  // Final state
+  if (checkpoints_ != nullptr) {
+    MakeCheckpoint(nullptr);
+  }
+
   // Adversaries
 
   for (auto& adversary : adversaries_) {
@@ -177,6 +359,15 @@ size_t World::Stop() {
   LOG_INFO("Clients stopped");
 
   actors_.clear();
+  actor_indices_.clear();
+  actor_streams_.clear();
+  last_stream_ = nullptr;
+  next_step_times_.clear();
+  stale_next_steps_.clear();
+  next_steps_.Clear();
+  next_step_versions_.clear();
+  bulk_batch_.clear();
+  bulk_touched_.clear();
 
   // Finalize
 
@@ -192,28 +383,52 @@ size_t World::Stop() {
 }
 
 size_t World::MakeSteps(size_t steps) {
-  size_t steps_made = 0;
-  for (size_t i = 0; i < steps; ++i) {
-    if (!Step()) {
-      break;
-    }
-    ++steps_made;
-  }
-  return steps_made;
+  return RunSteps(steps, nullptr);
 }
 
 void World::RunFor(Jiffies time_budget) {
-  while (TimeElapsed() < time_budget) {
-    if (!Step()) {
-      break;
-    }
+  RunSteps(SIZE_MAX, [this, time_budget]() {
+    return !(TimeElapsed() < time_budget);
+  });
+}
+
+void World::RunUntil(const StopCondition& done) {
+  RunSteps(SIZE_MAX, done);
+}
+
+void World::Cover(std::string_view site) {
+  if (coverage_ == nullptr) {
+    return;
+  }
+
+  GlobalAllocatorGuard g;
+
+  IActor* actor = CurrentActor();
+  std::string_view actor_name = actor != nullptr ? actor->Name() : "World";
+  coverage_->Hit(Coverage::MakePoint(actor_name, site));
+}
+
+uint64_t World::LogDecision(uint64_t value, const std::source_location& site) {
+  GlobalAllocatorGuard g;
+
+  IActor* actor = CurrentActor();
+  static const std::string kNoActor = "World";
+  const std::string& actor_name = actor != nullptr ? actor->Name() : kNoActor;
+
+  if (decision_replayer_) {
+    value = decision_replayer_->Replay(step_number_, actor_name, site);
+  }
+  if (decision_recorder_) {
+    decision_recorder_->Record(step_number_, actor_name, site, value);
   }
+  return value;
 }
 
 void World::RestartServer(const std::string& hostname) {
   WorldGuard g(this);
 
   FindServer(hostname)->FastReboot();
+  InvalidateAllNextSteps();
 }
 
 }  // namespace whirl::matrix
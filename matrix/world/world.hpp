@@ -7,6 +7,9 @@
 #include <matrix/world/actor.hpp>
 #include <matrix/world/actor_ctx.hpp>
 #include <matrix/world/random_source.hpp>
+#include <matrix/world/coverage.hpp>
+#include <matrix/world/decisions.hpp>
+#include <matrix/world/checkpoint.hpp>
 #include <matrix/time_model/time_model.hpp>
 #include <matrix/history/recorder.hpp>
 #include <matrix/log/backend.hpp>
@@ -15,6 +18,7 @@
 #include <matrix/time_model/catalog/adversary.hpp>
 
 #include <matrix/helpers/digest.hpp>
+#include <matrix/helpers/priority_queue.hpp>
 #include <matrix/helpers/untyped_dict.hpp>
 
 #include <timber/logger.hpp>
@@ -22,6 +26,10 @@
 #include <wheels/support/id.hpp>
 
 #include <deque>
+#include <functional>
+#include <optional>
+#include <source_location>
+#include <unordered_map>
 #include <vector>
 
 namespace whirl::matrix {
@@ -34,12 +42,28 @@ struct NextStep {
   TimePoint time;
 };
 
+struct NextStepEntry {
+  TimePoint time;
+  size_t actor_index;
+  // Entry is live while version matches actor's current version
+  uint64_t version;
+
+  // Earliest time, lowest index on ties
+  bool operator<(const NextStepEntry& that) const {
+    return time < that.time ||
+           (time == that.time && actor_index < that.actor_index);
+  }
+};
+
 //////////////////////////////////////////////////////////////////////
 
 class World {
+  // Nestable: restores enclosing world on exit
   struct WorldGuard {
     WorldGuard(World* world);
     ~WorldGuard();
+
+    World* prev;
   };
 
   using Servers = std::deque<Server>;
@@ -63,12 +87,12 @@ class World {
   }
 
   void AddPool(std::string pool_name, node::program::Main program, size_t size,
-               std::string name_template) {
+               std::string name_template, ServerOptions options = {}) {
     WorldGuard g(this);
 
     Servers& pool = pools_[pool_name];
     for (size_t i = 0; i < size; ++i) {
-      AddToPool(pool, program, pool_name, name_template);
+      AddToPool(pool, program, pool_name, name_template, options);
     }
   }
 
@@ -92,10 +116,21 @@ class World {
     return !adversaries_.empty();
   }
 
+  // Servers, clients and adversaries
+  size_t HostCount() const {
+    return ClusterSize() + clients_.size() + adversaries_.size();
+  }
+
   void SetTimeModel(ITimeModelPtr time_model) {
     time_model_ = std::move(time_model);
   }
 
+  // Off: poll every actor before each step, no bulk steps
+  // Reference behaviour for checking the cache, see `InvalidateActor`
+  void SetNextStepCache(bool on) {
+    next_step_cache_ = on;
+  }
+
   void WriteLogTo(const std::string& fpath) {
     log_backend_.AppendToFile(fpath);
   }
@@ -104,6 +139,50 @@ class World {
     tracer_.emplace(fpath);
   }
 
+  // Exploration
+
+  void SetRandomPrefix(RandomDecisions prefix) {
+    random_source_.SetPrefix(std::move(prefix));
+  }
+
+  void RecordRandomTo(RandomDecisions* sink, size_t limit) {
+    random_source_.RecordTo(sink, limit);
+  }
+
+  void CollectCoverageTo(Coverage* coverage) {
+    coverage_ = coverage;
+    log_backend_.CollectCoverageTo(coverage);
+  }
+
+  // Context: any
+  void Cover(std::string_view site);
+
+  // Context: any
+  // Next step of `actor` changed outside of its own step
+  // (fault injection: crash, reboot, pause, resume)
+  void InvalidateActor(IActor* actor);
+
+  // Decision log
+
+  void RecordDecisionsTo(const std::string& path) {
+    decision_recorder_.emplace(path);
+  }
+
+  void ReplayDecisionsFrom(const std::string& path) {
+    decision_replayer_.emplace(path);
+  }
+
+  // Determinism checks
+  void RecordCheckpointsTo(Checkpoints* sink, CheckpointOptions options) {
+    checkpoints_ = sink;
+    checkpoint_options_ = options;
+  }
+
+  // Fast-forward: nothing is logged before world step `step`
+  void LogFromStep(size_t step) {
+    log_from_step_ = step;
+  }
+
   IServerTimeModelPtr MakeServerTimeModel(const std::string& hostname) {
     // TODO
     if (hostname.starts_with("Adversary")) {
@@ -115,6 +194,8 @@ class World {
   void Start();
   void SetConfigGlobals();
 
+  using StopCondition = std::function<bool()>;
+
   // Returns false if simulation is in deadlock state
   bool Step();
 
@@ -127,6 +208,9 @@ class World {
   // Time budget is _virtual_!
   void RunFor(Jiffies time_budget);
 
+  // Until `done` holds (checked before each step) or deadlock
+  void RunUntil(const StopCondition& done);
+
   void RestartServer(const std::string& hostname);
 
   // Methods used by running actors
@@ -145,6 +229,11 @@ class World {
     return *FindServer(hostname);
   }
 
+  // Context: Adversary
+  Server& GetFaultyServer(const std::string& hostname) {
+    return *FindServer(hostname);
+  }
+
   net::Network& GetNetwork() {
     return network_;
   }
@@ -153,6 +242,11 @@ class World {
     return step_number_;
   }
 
+  // Steps made inside bulk steps beyond the first one
+  size_t SkippedSteps() const {
+    return skipped_steps_;
+  }
+
   log::LogBackend& GetLog() {
     return log_backend_;
   }
@@ -195,6 +289,21 @@ class World {
     return server->GetStdout();
   }
 
+  db::Stats GetDbStats(const std::string& hostname) {
+    const Server* server = FindServer(hostname);
+    return server->GetDbStats();
+  }
+
+  process::CpuStats GetCpuStats(const std::string& hostname) {
+    const Server* server = FindServer(hostname);
+    return server->GetCpuStats();
+  }
+
+  net::TransportStats GetTransportStats(const std::string& hostname) {
+    const Server* server = FindServer(hostname);
+    return server->GetTransportStats();
+  }
+
   TimePoint Now() const {
     return time_.Now();
   }
@@ -203,8 +312,12 @@ class World {
     return time_.Now() - start_time_;
   }
 
-  uint64_t RandomNumber() {
-    return random_source_.Next();
+  uint64_t RandomNumber(const std::source_location& site) {
+    uint64_t value = NextRandomNumber();
+    if (decision_recorder_ || decision_replayer_) {
+      return LogDecision(value, site);
+    }
+    return value;
   }
 
   ITimeModel* TimeModel() const {
@@ -239,6 +352,40 @@ class World {
  private:
   static ITimeModelPtr DefaultTimeModel();
 
+  uint64_t NextRandomNumber() {
+    RandomStream& stream = CurrentRandomStream();
+    if (random_source_.IsRecording()) {
+      GlobalAllocatorGuard g;
+      return random_source_.Next(stream);
+    }
+    return random_source_.Next(stream);
+  }
+
+  // Stream of the current actor, "World" outside of actors
+  RandomStream& CurrentRandomStream() {
+    const IActor* actor = CurrentActor();
+    // Consecutive draws are usually made by the same actor
+    if (last_stream_ != nullptr && actor == last_stream_actor_) {
+      return *last_stream_;
+    }
+
+    auto it = actor_streams_.find(actor);
+    if (it == actor_streams_.end()) {
+      GlobalAllocatorGuard g;
+      RandomStream* stream = random_source_.Stream(
+          actor != nullptr ? actor->Name() : "World");
+      it = actor_streams_.emplace(actor, stream).first;
+    }
+
+    last_stream_actor_ = actor;
+    last_stream_ = it->second;
+    return *last_stream_;
+  }
+
+  uint64_t LogDecision(uint64_t value, const std::source_location& site);
+
+  void MakeCheckpoint(const IActor* actor);
+
   std::string MakeServerName(std::string name_template, size_t index) {
     wheels::StringBuilder name;
     name << name_template << '-' << index;
@@ -246,17 +393,25 @@ class World {
   }
 
   void AddToPool(Servers& pool, node::program::Main program,
-                 std::string pool_name, std::string host_name_template) {
+                 std::string pool_name, std::string host_name_template,
+                 ServerOptions options = {}) {
     auto host_name = MakeServerName(host_name_template, pool.size() + 1);
-    AddServerImpl(pool, program, pool_name, host_name);
+    AddServerImpl(pool, program, pool_name, host_name, options);
   }
 
   // Returns host name
   void AddServerImpl(Servers& pool, node::program::Main program,
-                     std::string pool_name, std::string hostname) {
+                     std::string pool_name, std::string hostname,
+                     ServerOptions options = {}) {
     size_t id = server_ids_.NextId();
 
-    pool.emplace_back(network_, ServerConfig{id, hostname, pool_name}, program);
+    WHEELS_VERIFY(options.racks > 0, "Pool without racks");
+
+    ServerConfig config{id, hostname, pool_name, options};
+    config.zone = network_.GetTopology().GetZone(options.zone);
+    config.rack = pool.size() % options.racks;
+
+    pool.emplace_back(network_, config, program);
 
     network_.AddServer(&pool.back());
     AddActor(&pool.back());
@@ -286,16 +441,46 @@ class World {
   }
 
   void AddActor(IActor* actor) {
+    actor_indices_.emplace(actor, actors_.size());
     actors_.push_back(actor);
+    next_step_times_.emplace_back();
+    next_step_versions_.push_back(0);
+    InvalidateNextStep(actor);
   }
 
   std::optional<NextStep> FindNextStep();
 
+  // Next step cache
+
+  void InvalidateNextStep(IActor* actor);
+  void InvalidateAllNextSteps();
+  // Actors that could be affected by the step
+  void InvalidateAfterStep(IActor* actor);
+  void RefreshNextSteps();
+
+  // At most `max_steps` steps, returns number of steps made
+  size_t RunSteps(size_t max_steps, const StopCondition& done);
+
+  // Quiescent world: every actor waits for a timer or a packet.
+  // Makes all steps due at `first.time` without global rescans,
+  // in the same (time, actor index) order
+  size_t MakeBulkStep(const NextStep& first, size_t max_steps,
+                      const StopCondition& done);
+
+  // Step numbering, logging and checkpoints
+  void TakeStep(const NextStep& next);
+
+  // Executes chosen step
+  void MakeStep(const NextStep& next);
+
  private:
   const size_t seed_;
 
   Time time_;
   RandomSource random_source_;
+  std::unordered_map<const IActor*, RandomStream*> actor_streams_;
+  const IActor* last_stream_actor_{nullptr};
+  RandomStream* last_stream_{nullptr};
   guids::GuidGenerator guids_;
 
   ITimeModelPtr time_model_;
@@ -315,9 +500,28 @@ class World {
   // Event loop
 
   std::vector<IActor*> actors_;
+  std::unordered_map<const IActor*, size_t> actor_indices_;
   ActorContext active_;
 
+  // Cached `NextStepTime` of runnable actors,
+  // recomputed only for invalidated actors
+  std::vector<std::optional<TimePoint>> next_step_times_;
+  std::vector<size_t> stale_next_steps_;
+  // Min-heap of cached next steps, ordered by (time, actor index)
+  // Superseded entries are dropped lazily, see `next_step_versions_`
+  // Small worlds use linear scan of `next_step_times_` instead
+  PriorityQueue<NextStepEntry> next_steps_;
+  std::vector<uint64_t> next_step_versions_;
+  bool next_step_heap_{false};
+
+  // Bulk step: actors due at current time, next one at the back
+  std::vector<size_t> bulk_batch_;
+  std::vector<size_t> bulk_touched_;
+
   size_t step_number_{0};
+  size_t skipped_steps_{0};
+
+  bool next_step_cache_{true};
 
   TimePoint start_time_;
 
@@ -328,6 +532,15 @@ class World {
 
   UntypedDict globals_;
 
+  Coverage* coverage_{nullptr};
+
+  std::optional<DecisionRecorder> decision_recorder_;
+  std::optional<DecisionReplayer> decision_replayer_;
+  size_t log_from_step_{0};
+
+  Checkpoints* checkpoints_{nullptr};
+  CheckpointOptions checkpoint_options_;
+
   timber::Logger logger_;
 };
 